@@ -0,0 +1,49 @@
+//
+//  file: %deci-standalone.h
+//  summary: "What deci.c takes from sys-core.h, for building libdeci alone"
+//  project: "Rebol 3 Interpreter and Run-time"
+//  homepage: https://github.com/metaeducation/ren-c/
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// With DECI_STANDALONE defined, %deci.h includes this instead of expecting
+// %sys-core.h to have been included, so %deci.c can be compiled and linked
+// without the interpreter (see %libdeci/Makefile).
+//
+// The only service deci.c needs from the core is panic(), for the errors
+// of the unchecked operations.  Here those call the error handler, which
+// must not return: it can longjmp() out, or end the program.  Without one
+// (or if it returns) the program is aborted.
+//
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include <iso646.h>
+
+typedef unsigned char Byte;
+
+#define INLINE static inline
+#define NOOP ((void)0)
+
+/* gets DECI_OVERFLOW or DECI_DIVIDE_BY_ZERO, see deci_set_error_handler() */
+typedef void (*deci_error_handler) (uint32_t flag);
+
+/* sets the handler for the errors of the unchecked operations, returns the previous one */
+deci_error_handler deci_set_error_handler (deci_error_handler handler);
@@ -9,6 +9,7 @@
 //=////////////////////////////////////////////////////////////////////////=//
 //
 // Copyright 2012 REBOL Technologies
+// Copyright 2026 Ren-C Open Source Contributors
 // REBOL is a trademark of REBOL Technologies
 //
 // See README.md and CREDITS.md for more information.
@@ -50,15 +51,23 @@
 //
 //=//// NOTES /////////////////////////////////////////////////////////////=//
 //
-// A. While Ren-C aggressively reformatted/reorganized most of R3-Alpha,
-//    deci was left alone as much as possible.  Hence the original copyright
-//    date and license apply.  (Ren-C itself is LGPL licensed, but no material
-//    changes were made to this Apache2-licensed file, so it retains its
-//    original license.)
+// A. deci was at first carried over from R3-Alpha as-is, but this extension
+//    has since rewritten most of it: the significand kernels on 64-bit limbs
+//    (see [G]), the conversions to and from doubles and strings, deci_mod(),
+//    and rounding to powers of ten; and it added the checked, batch, column,
+//    accumulator, sort key and _Decimal128 code.  Still R3-Alpha's are the
+//    deci layout and its 12-byte binary form, the algorithms of add,
+//    multiply and divide (same shift estimates and results, wider limbs),
+//    make_comparable(), and the rounding functions deci_truncate() through
+//    deci_half_floor().
 //
-// B. Despite [A], since this is being used in an extension intended to
-//    compile against the current Ren-C codebase, it was necessary to make
-//    some type changes:
+//    The new code is contributed under the Apache 2.0 license of the
+//    R3-Alpha code, not Ren-C's LGPL, so the file has one license: the
+//    original parts are copyright REBOL Technologies, the rest the Ren-C
+//    contributors.
+//
+// B. To compile against the current Ren-C codebase, the R3-Alpha types were
+//    renamed:
 //
 //        REBYTE => Byte       // not uint8_t...
 //        REBINT => int32_t
@@ -105,28 +114,128 @@
 //     Re-engineering deci to use that style would be a lot of work, so we
 //     just use abrupt panics here, as R3-Alpha did.
 //
+//     The arithmetic kernels take a status pointer, though: NULL panics as
+//     before, otherwise the error is added to the status flags and a zero
+//     result is returned.  The `_checked` functions expose that, so callers
+//     can test a whole batch once instead of using RECOVER_SCOPE().
+//
 // F. A test for `if (m == 1)` triggered a warning in gcc 4.9.2 in -O2 mode
 //    that array subscripting with [m - 1] could be below array bounds, due to
 //    not knowing the caller wouldn't pass in zero.  Changed test to
 //    `if (m <= 1)`, added assert m is not zero.
 //
+// G. The significand kernels were rewritten to use 64-bit limbs with
+//    `unsigned __int128` intermediates instead of 32-bit limbs with uint64_t
+//    intermediates.  A significand is now two limbs instead of three (a
+//    "double significand" is four instead of six), so a multiplication is
+//    four partial products instead of nine.  Decimal shifts go 19 digits
+//    per step instead of 9.  Results are bit-identical with the 32-bit code:
+//    the double-precision estimates that pick shift amounts are still made
+//    from the same values, and the remaining arithmetic is exact.
+//
+//    MSVC has no `unsigned __int128`, nor the GCC builtins and attributes
+//    used throughout, so the file needs GCC or Clang (clang-cl or MinGW on
+//    Windows); the extension is 64-bit only anyway (see README.md).
+//
+// H. The column operations (deci_columns_add_n() etc.) have AVX2 and
+//    AVX-512 versions on x86-64, picked at runtime by CPUID.  The vector
+//    loops only take the common case, a block of values with equal exponents
+//    and significands below 2^64, and give any other block to the scalar
+//    kernels, so results are the same bit for bit on every machine.  Build
+//    with DECI_NO_SIMD (or DECI_NO_AVX512) to leave those versions out.
+//
+// I. Nothing here needs the interpreter but panic(), so with DECI_STANDALONE
+//    the file builds on its own as libdeci (see %libdeci/Makefile), and the
+//    panics go to an error handler set with deci_set_error_handler().
+//
+// J. With DECI_DECIMAL128 the add, multiply and divide kernels do the
+//    significand arithmetic in C23/TR 24732 _Decimal128 (BID encoding, as
+//    GCC has it on x86) instead of the 64-bit limbs, for comparing the two
+//    engines on a given deployment.  The deci layout, the API and the
+//    results are the same bit for bit: _Decimal128 has 34 digits, so the
+//    kernels steer it to an exact result, or to one truncated with a known
+//    fraction flag, and round that to 26 digits with the code above.  The
+//    other operations keep the limb code, they use these kernels as callers.
+//    _Decimal128 is C only, so this backend needs deci.c built as C; `make
+//    test` in %libdeci/ checks that the two backends give the same results.
+//
+
 
+#ifdef DECI_STANDALONE  // see [I]
+    #include <math.h>
+    #include <stdlib.h>  // abort()
 
-#include "sys-core.h"
-#include "tmp-mod-deci.h"
+    #include "deci.h"
 
-#include "deci.h"
-#include "sys-dec-to-char.h"
+    static deci_error_handler error_handler = NULL;
 
-#define OVERFLOW_ERROR          panic (Error_Overflow_Raw())  // see [E]
-#define DIVIDE_BY_ZERO_ERROR    panic (Error_Zero_Divide_Raw())
+    deci_error_handler deci_set_error_handler (deci_error_handler handler) {
+        deci_error_handler previous = error_handler;
+        error_handler = handler;
+        return previous;
+    }
+
+    __attribute__((noreturn, cold)) static void deci_error (uint32_t flag) {
+        if (error_handler) error_handler (flag);
+        abort ();
+    }
+
+    #define OVERFLOW_ERROR          deci_error (DECI_OVERFLOW)
+    #define DIVIDE_BY_ZERO_ERROR    deci_error (DECI_DIVIDE_BY_ZERO)
+#else
+    #include "sys-core.h"
+    #include "tmp-mod-deci.h"
+
+    #include "deci.h"
+
+    #define OVERFLOW_ERROR          panic (Error_Overflow_Raw())  // see [E]
+    #define DIVIDE_BY_ZERO_ERROR    panic (Error_Zero_Divide_Raw())
+#endif
 
 #define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
 
-#define MASK32(i) (uint32_t)(i)
+#define MASK64(i) (uint64_t)(i)
 
 #define two_to_32 4294967296.0
 #define two_to_32l 4294967296.0l
+#define two_to_64 18446744073709551616.0
+
+#if !(defined(__GNUC__) || defined(__clang__)) || !defined(__SIZEOF_INT128__)
+    #error "deci.c needs GCC or Clang with unsigned __int128, see [G]"
+#endif
+
+typedef unsigned __int128 uint128_t;  // see [G]
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(DECI_NO_SIMD)
+    #include <immintrin.h>  // see [H]
+    #define DECI_SIMD
+#endif
+
+/* for the scalar operations also expanded in the array loops */
+#define ALWAYS_INLINE INLINE __attribute__((always_inline))
+
+#if defined(DECI_DECIMAL128) && !defined(__DECIMAL_BID_FORMAT__)
+    #error "DECI_DECIMAL128 needs a compiler with BID _Decimal128, see [J]"
+#endif
+#if defined(DECI_DECIMAL128) && defined(__cplusplus)
+    #error "DECI_DECIMAL128 needs a C build, C++ has no _Decimal128, see [J]"
+#endif
+
+/*
+    Reports an error flag to status st, or panics if st is NULL;
+    the unchecked operations pass NULL to the inlined kernels, so the test
+    is folded away there;
+*/
+INLINE void raise_status (uint32_t *st, uint32_t flag) {
+    if (st) *st |= flag;
+    else if (flag == DECI_DIVIDE_BY_ZERO) DIVIDE_BY_ZERO_ERROR;
+    else OVERFLOW_ERROR;
+}
+
+/* significand of deci a as 64-bit limbs */
+#define M_LO(a) ((uint64_t)(a).m1 << 32 | (uint64_t)(a).m0)
+#define M_HI(a) ((uint64_t)(a).m2)
 
 /* useful deci constants */
 static const deci deci_zero = {0u, 0u, 0u, 0u, 0};
@@ -134,7 +243,51 @@ static const deci deci_one = {1u, 0u, 0u, 0u, 0};
 static const deci deci_minus_one = {1u, 0u, 0u, 1u, 0};
 /* end of deci constants */
 
-static const uint32_t min_int64_t_as_deci[] = {0u, 0x80000000u, 0u};
+static const uint64_t min_int64_t_as_deci[] = {0x8000000000000000u, 0u};
+
+/* Stores significand a (2 limbs) into deci c */
+INLINE void m_to_deci (deci *c, const uint64_t a[]) {
+    c->m0 = (uint32_t)a[0];
+    c->m1 = (uint32_t)(a[0] >> 32);
+    c->m2 = (uint32_t)a[1];
+}
+
+/*
+    Divides the 128-bit number hi:lo by d, hi < d required;
+    returns the quotient and stores the remainder to r;
+*/
+INLINE uint64_t div_128 (uint64_t hi, uint64_t lo, uint64_t d, uint64_t *r) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    uint64_t q;
+    __asm__ ("divq %4" : "=a" (q), "=d" (*r) : "a" (lo), "d" (hi), "rm" (d));
+    return q;
+#else
+    uint128_t n = (uint128_t)hi << 64 | lo;
+    *r = (uint64_t)(n % d);
+    return (uint64_t)(n / d);
+#endif
+}
+
+/*
+    Divides u1:u0 by the normalized limb d with reciprocal v, u1 < d required;
+    returns the quotient and stores the remainder to r;
+    see Moller, Granlund: "Improved division by invariant integers" (2011);
+*/
+INLINE uint64_t div_2by1 (uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t *r) {
+    uint128_t p = (uint128_t) v * u1 + ((uint128_t) u1 << 64 | u0);
+    uint64_t q1 = (uint64_t)(p >> 64) + 1, q0 = MASK64(p);
+    uint64_t rr = u0 - q1 * d;
+    if (rr > q0) {
+        q1--;
+        rr += d;
+    }
+    if (rr >= d) {
+        q1++;
+        rr -= d;
+    }
+    *r = rr;
+    return q1;
+}
 
 /*
     Compare significand a and significand b;
@@ -142,107 +295,117 @@ static const uint32_t min_int64_t_as_deci[] = {0u, 0x80000000u, 0u};
     0 means a = b;
     1 means a > b;
 */
-INLINE int32_t m_cmp (int32_t n, const uint32_t a[], const uint32_t b[]) {
+INLINE int32_t m_cmp (int32_t n, const uint64_t a[], const uint64_t b[]) {
     int32_t i;
     for (i = n - 1; i >= 0; i--)
         if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
     return 0;
 }
 
-INLINE bool m_is_zero (int32_t n, const uint32_t a[]) {
+INLINE bool m_is_zero (int32_t n, const uint64_t a[]) {
     int32_t i;
     for (i = 0; (i < n) and (a[i] == 0); i++) NOOP;  // NOOP added, see [D]
     return i == n;
 }
 
 /* unnormalized powers of ten */
-static const uint32_t P[][3] = {
-    {1u, 0u, 0u},                           /* 1e0 */
-    {10u, 0u, 0u},                          /* 1e1 */
-    {100u, 0u, 0u},                         /* 1e2 */
-    {1000u, 0u, 0u},                        /* 1e3 */
-    {10000u, 0u, 0u},                       /* 1e4 */
-    {100000u, 0u, 0u},                      /* 1e5 */
-    {1000000u, 0u, 0u},                     /* 1e6 */
-    {10000000u, 0u, 0u},                    /* 1e7 */
-    {100000000u, 0u, 0u},                   /* 1e8 */
-    {1000000000u, 0u, 0u},                  /* 1e9 */
-    {1410065408u, 2u, 0u},                  /* 1e10 */
-    {1215752192u, 23u, 0u},                 /* 1e11 */
-    {3567587328u, 232u, 0u},                /* 1e12 */
-    {1316134912u, 2328u, 0u},               /* 1e13 */
-    {276447232u, 23283u, 0u},               /* 1e14 */
-    {2764472320u, 232830u, 0u},             /* 1e15 */
-    {1874919424u, 2328306u, 0u},            /* 1e16 */
-    {1569325056u, 23283064u, 0u},           /* 1e17 */
-    {2808348672u, 232830643u, 0u},          /* 1e18 */
-    {2313682944u, 2328306436u, 0u},         /* 1e19 */
-    {1661992960u, 1808227885u, 5u},         /* 1e20 */
-    {3735027712u, 902409669u, 54u},         /* 1e21 */
-    {2990538752u, 434162106u, 542u},        /* 1e22 */
-    {4135583744u, 46653770u, 5421u},        /* 1e23 */
-    {2701131776u, 466537709u, 54210u},      /* 1e24 */
-    {1241513984u, 370409800u, 542101u},     /* 1e25 */
-    {3825205248u, 3704098002u, 5421010u}    /* 1e26 */
+static const uint64_t P[][2] = {
+    {1u, 0u},                               /* 1e0 */
+    {10u, 0u},                              /* 1e1 */
+    {100u, 0u},                             /* 1e2 */
+    {1000u, 0u},                            /* 1e3 */
+    {10000u, 0u},                           /* 1e4 */
+    {100000u, 0u},                          /* 1e5 */
+    {1000000u, 0u},                         /* 1e6 */
+    {10000000u, 0u},                        /* 1e7 */
+    {100000000u, 0u},                       /* 1e8 */
+    {1000000000u, 0u},                      /* 1e9 */
+    {10000000000u, 0u},                     /* 1e10 */
+    {100000000000u, 0u},                    /* 1e11 */
+    {1000000000000u, 0u},                   /* 1e12 */
+    {10000000000000u, 0u},                  /* 1e13 */
+    {100000000000000u, 0u},                 /* 1e14 */
+    {1000000000000000u, 0u},                /* 1e15 */
+    {10000000000000000u, 0u},               /* 1e16 */
+    {100000000000000000u, 0u},              /* 1e17 */
+    {1000000000000000000u, 0u},             /* 1e18 */
+    {10000000000000000000u, 0u},            /* 1e19 */
+    {7766279631452241920u, 5u},             /* 1e20 */
+    {3875820019684212736u, 54u},            /* 1e21 */
+    {1864712049423024128u, 542u},           /* 1e22 */
+    {200376420520689664u, 5421u},           /* 1e23 */
+    {2003764205206896640u, 54210u},         /* 1e24 */
+    {1590897978359414784u, 542101u},        /* 1e25 */
+    {15908979783594147840u, 5421010u}       /* 1e26 */
 };
 
+/* largest power of ten fitting a limb, the step of decimal shifts */
+#define MAX_LIMB_DIGITS 19
+
 /* 1e26 as double significand */
-static const uint32_t P26[] = {3825205248u, 3704098002u, 5421010u, 0u, 0u, 0u};
+static const uint64_t P26[] = {15908979783594147840u, 5421010u, 0u, 0u};
 /* 1e26 - 1 */
-static const uint32_t P26_1[] = {3825205247u, 3704098002u, 5421010u};
+static const uint64_t P26_1[] = {15908979783594147839u, 5421010u};
 
 /*
-    Computes max decimal shift left for nonzero significand a with length 3;
+    Computes max decimal shift left for nonzero significand a with length 2;
     using double arithmetic;
 */
-INLINE int32_t max_shift_left (const uint32_t a[]) {
+INLINE int32_t max_shift_left (const uint64_t a[]) {
     int32_t i;
-    i = (int32_t)(log10((a[2] * two_to_32 + a[1]) * two_to_32 + a[0]) + 0.5);
-    return m_cmp (3, P[i], a) <= 0 ? 25 - i : 26 - i;
+    i = (int32_t)(log10(a[1] * two_to_64 + a[0]) + 0.5);
+    return m_cmp (2, P[i], a) <= 0 ? 25 - i : 26 - i;
+}
+
+/* Counts the decimal digits of nonzero significand a */
+INLINE int32_t m_digits (const uint64_t a[2]) {
+    int32_t bits = a[1] ? 128 - __builtin_clzll (a[1]) : 64 - __builtin_clzll (a[0]);
+    int32_t t = (bits * 1233) >> 12; /* floor (log10 (2 ** bits)) */
+    return t + (m_cmp (2, a, P[t]) >= 0);
 }
 
 /* limits for "double significand" right shift */
-static const uint32_t Q[][6] = {
-    {3892314107u, 2681241660u, 54210108u, 0u, 0u, 0u},                      /* 1e27-5e0 */
-    {268435406u, 1042612833u, 542101086u, 0u, 0u, 0u},                      /* 1e28-5e1 */
-    {2684354060u, 1836193738u, 1126043566u, 1u, 0u, 0u},                    /* 1e29-5e2 */
-    {1073736824u, 1182068202u, 2670501072u, 12u, 0u, 0u},                   /* 1e30-5e3 */
-    {2147433648u, 3230747430u, 935206946u, 126u, 0u, 0u},                   /* 1e31-5e4 */
-    {4294467296u, 2242703232u, 762134875u, 1262u, 0u, 0u},                  /* 1e32-5e5 */
-    {4289967296u, 952195849u, 3326381459u, 12621u, 0u, 0u},                 /* 1e33-5e6 */
-    {4244967296u, 932023907u, 3199043520u, 126217u, 0u, 0u},                /* 1e34-5e7 */
-    {3794967296u, 730304487u, 1925664130u, 1262177u, 0u, 0u},               /* 1e35-5e8 */
-    {3589934592u, 3008077582u, 2076772117u, 12621774u, 0u, 0u},             /* 1e36-5e9 */
-    {1539607552u, 16004756u, 3587851993u, 126217744u, 0u, 0u},              /* 1e37-5e10 */
-    {2511173632u, 160047563u, 1518781562u, 1262177448u, 0u, 0u},            /* 1e38-5e11 */
-    {3636899840u, 1600475635u, 2302913732u, 4031839891u, 2u, 0u},           /* 1e39-5e12 */
-    {2009260032u, 3119854470u, 1554300843u, 1663693251u, 29u, 0u},          /* 1e40-5e13*/
-    {2912731136u, 1133773632u, 2658106549u, 3752030625u, 293u, 0u},         /* 1e41-5e14 */
-    {3357507584u, 2747801734u, 811261716u, 3160567888u, 2938u, 0u},         /* 1e42-5e15 */
-    {3510304768u, 1708213571u, 3817649870u, 1540907809u, 29387u, 0u},       /* 1e43-5e16 */
-    {743309312u, 4197233830u, 3816760335u, 2524176210u, 293873u, 0u},       /* 1e44-5e17 */
-    {3138125824u, 3317632637u, 3807864991u, 3766925628u, 2938735u, 0u},     /* 1e45-5e18 */
-    {1316487168u, 3111555305u, 3718911549u, 3309517920u, 29387358u, 0u},    /* 1e46-5e19 */
-    {279969792u, 1050781981u, 2829377129u, 3030408136u, 293873587u, 0u},    /* 1e47-5e20 */
-    {2799697920u, 1917885218u, 2523967516u, 239310294u, 2938735877u, 0u},   /* 1e48-5e21 */
-    {2227175424u, 1998983002u, 3764838684u, 2393102945u, 3617554994u, 6u},  /* 1e49-5e22 */
-    {796917760u, 2809960841u, 3288648476u, 2456192978u, 1815811577u, 68u},  /* 1e50-5e23 */
-    {3674210304u, 2329804635u, 2821713694u, 3087093307u, 978246591u, 684u}, /* 1e51-5e24 */
-    {2382364672u, 1823209878u, 2447333169u, 806162004u, 1192531325u, 6842u} /* 1e52-5e25 */
+static const uint64_t Q[][4] = {
+    {11515845246265065467u, 54210108u, 0u, 0u},                             /* 1e27-5e0 */
+    {4477988020393344974u, 542101086u, 0u, 0u},                             /* 1e28-5e1 */
+    {7886392056514346508u, 5421010862u, 0u, 0u},                            /* 1e29-5e2 */
+    {5076944270305258616u, 54210108624u, 0u, 0u},                           /* 1e30-5e3 */
+    {13875954555633482928u, 542101086242u, 0u, 0u},                        /* 1e31-5e4 */
+    {9632337040367967968u, 5421010862427u, 0u, 0u},                         /* 1e32-5e5 */
+    {4089650035131921600u, 54210108624275u, 0u, 0u},                        /* 1e33-5e6 */
+    {4003012203900112768u, 542101086242752u, 0u, 0u},                       /* 1e34-5e7 */
+    {3136633891582024448u, 5421010862427522u, 0u, 0u},                      /* 1e35-5e8 */
+    {12919594842110692864u, 54210108624275221u, 0u, 0u},                    /* 1e36-5e9 */
+    {68739905140067328u, 542101086242752217u, 0u, 0u},                      /* 1e37-5e10 */
+    {687399051400673280u, 5421010862427522170u, 0u, 0u},                    /* 1e38-5e11 */
+    {6873990514006732800u, 17316620476856118468u, 2u, 0u},                  /* 1e39-5e12 */
+    {13399672918938673152u, 7145508105175220139u, 29u, 0u},                 /* 1e40-5e13 */
+    {4869520673419870208u, 16114848830623546549u, 293u, 0u},                /* 1e41-5e14 */
+    {11801718586779598848u, 13574535716559052564u, 2938u, 0u},              /* 1e42-5e15 */
+    {7336721425538678784u, 6618148649623664334u, 29387u, 0u},               /* 1e43-5e16 */
+    {18026982034258132992u, 10841254275107988495u, 293873u, 0u},            /* 1e44-5e17 */
+    {14249123679195365376u, 16178822382532126879u, 2938735u, 0u},           /* 1e45-5e18 */
+    {13364028275986792448u, 14214271235644855869u, 29387358u, 0u},          /* 1e46-5e19 */
+    {4513074243901063168u, 13015503840481697385u, 293873587u, 0u},          /* 1e47-5e20 */
+    {8237254291591528448u, 1027829888850112540u, 2938735877u, 0u},          /* 1e48-5e21 */
+    {8585566621077078016u, 10278298888501125404u, 29387358770u, 0u},        /* 1e49-5e22 */
+    {12068689915932573696u, 10549268516463495964u, 293873587705u, 0u},      /* 1e50-5e23 */
+    {10006434717068427264u, 13258964796087201566u, 2938735877055u, 0u},     /* 1e51-5e24 */
+    {7830626802136514560u, 3462439444905154353u, 29387358770557u, 0u}       /* 1e52-5e25 */
 };
 
 /*
     Computes minimal decimal shift right for "double significand" with
-    length 6 to fit length 3, using double arithmetic.
+    length 4 to fit length 2, using double arithmetic.
 */
-INLINE int32_t min_shift_right (const uint32_t a[6]) {
+INLINE int32_t min_shift_right (const uint64_t a[4]) {
     int32_t i;
-    if (m_cmp (6, a, P26) < 0) return 0;
+    if (m_cmp (4, a, P26) < 0) return 0;
     i = (int32_t) (log10 (
-        ((((a[5] * two_to_32 + a[4]) * two_to_32 + a[3]) * two_to_32 + a[2]) * two_to_32 + a[1]) * two_to_32 + a[0]
+        ((a[3] * two_to_64 + a[2]) * two_to_64 + a[1]) * two_to_64 + a[0]
     ) + 0.5);
     if (i == 26) return 1;
-    return (m_cmp (6, Q[i - 27], a) <= 0) ? i - 25 : i - 26;
+    return (m_cmp (4, Q[i - 27], a) <= 0) ? i - 25 : i - 26;
 }
 
 /* Finds out if deci a is zero */
@@ -263,91 +426,91 @@ deci deci_abs (deci a) {
 }
 
 /*
-    Adds unsigned 32-bit value b to significand a;
+    Adds unsigned 64-bit value b to significand a;
     a must be "large enough" to contain the sum;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE void m_add_1 (uint32_t *a, const uint32_t b) {
-    uint64_t c = (uint64_t) b;
+INLINE void m_add_1 (uint64_t *a, const uint64_t b) {
+    uint128_t c = (uint128_t) b;
     while (c) {
-        c += (uint64_t) *a;
-        *(a++) = (uint32_t)c;
-        c >>= 32;
+        c += (uint128_t) *a;
+        *(a++) = MASK64(c);
+        c >>= 64;
     }
 }
 
 /*
-    Subtracts unsigned 32-bit value b from significand a;
+    Subtracts unsigned 64-bit value b from significand a;
     using 64-bit arithmetic;
 */
-INLINE void m_subtract_1 (uint32_t *a, const uint32_t b) {
-    int64_t c = - (int64_t) b;
+INLINE void m_subtract_1 (uint64_t *a, const uint64_t b) {
+    uint64_t c = b, t;
     while (c) {
-        c += 0xffffffffu + (int64_t)*a + 1;
-        *(a++) = MASK32(c);
-        c = (c >> 32) - 1;
+        t = *a;
+        *(a++) = t - c;
+        c = t < c;
     }
 }
 
 /*
     Adds significand b to significand a yielding sum s;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE void m_add (int32_t n, uint32_t s[], const uint32_t a[], const uint32_t b[]) {
-    uint64_t c = (uint64_t) 0;
+INLINE void m_add (int32_t n, uint64_t s[], const uint64_t a[], const uint64_t b[]) {
+    uint128_t c = (uint128_t) 0;
     int32_t i;
     for (i = 0; i < n; i++) {
-        c += (uint64_t) a[i] + (uint64_t) b[i];
-        s[i] = MASK32(c);
-        c >>= 32;
+        c += (uint128_t) a[i] + (uint128_t) b[i];
+        s[i] = MASK64(c);
+        c >>= 64;
     }
-    s[n] = (uint32_t)c;
+    s[n] = (uint64_t)c;
 }
 
 /*
     Subtracts significand b from significand a yielding difference d;
     returns carry flag to signal whether the result is negative;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE int32_t m_subtract (int32_t n, uint32_t d[], const uint32_t a[], const uint32_t b[]) {
-    uint64_t c = (uint64_t) 1;
+INLINE int32_t m_subtract (int32_t n, uint64_t d[], const uint64_t a[], const uint64_t b[]) {
+    uint128_t c = (uint128_t) 1;
     int32_t i;
     for (i = 0; i < n; i++) {
-        c += (uint64_t) 0xffffffffu + (uint64_t) a[i] - (uint64_t) b[i];
-        d[i] = MASK32(c);
-        c >>= 32;
+        c += (uint128_t) UINT64_MAX + (uint128_t) a[i] - (uint128_t) b[i];
+        d[i] = MASK64(c);
+        c >>= 64;
     }
     return (int32_t) c - 1;
 }
 
 /*
     Negates significand a;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE void m_negate (int32_t n, uint32_t a[]) {
-    uint64_t c = (uint64_t) 1;
+INLINE void m_negate (int32_t n, uint64_t a[]) {
+    uint128_t c = (uint128_t) 1;
     int32_t i;
     for (i = 0; i < n; i++) {
-        c += (uint64_t) 0xffffffffu - (uint64_t) a[i];
-        a[i] = MASK32(c);
-        c >>= 32;
+        c += (uint128_t) UINT64_MAX - (uint128_t) a[i];
+        a[i] = MASK64(c);
+        c >>= 64;
     }
 }
 
 /*
     Multiplies significand a by b storing the product to p;
     p and a may be the same;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE void m_multiply_1 (int32_t n, uint32_t p[], const uint32_t a[], uint32_t b) {
+INLINE void m_multiply_1 (int32_t n, uint64_t p[], const uint64_t a[], uint64_t b) {
     int32_t j;
-    uint64_t f = b, g = (uint64_t) 0;
+    uint128_t f = b, g = (uint128_t) 0;
     for (j = 0; j < n; j++) {
-        g += f * (uint64_t) a[j];
-        p[j] = MASK32(g);
-        g >>= 32;
+        g += f * (uint128_t) a[j];
+        p[j] = MASK64(g);
+        g >>= 64;
     }
-    p[n] = (uint32_t) g;
+    p[n] = (uint64_t) g;
 }
 
 /*
@@ -355,10 +518,10 @@ INLINE void m_multiply_1 (int32_t n, uint32_t p[], const uint32_t a[], uint32_t
     a must be longer than the complete result;
     n is the initial length of a;
 */
-INLINE void dsl (int32_t n, uint32_t a[], int32_t shift) {
+INLINE void dsl (int32_t n, uint64_t a[], int32_t shift) {
     int32_t shift1;
     for (; shift > 0; shift -= shift1) {
-        shift1 = 9 <= shift ? 9 : shift;
+        shift1 = MAX_LIMB_DIGITS <= shift ? MAX_LIMB_DIGITS : shift;
         m_multiply_1 (n, a, a, P[shift1][0]);
         if (a[n] != 0) n++;
     }
@@ -366,21 +529,21 @@ INLINE void dsl (int32_t n, uint32_t a[], int32_t shift) {
 
 /*
     Multiplies significand a by significand b yielding the product p;
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE void m_multiply (uint32_t p[/* n + m */], int32_t n, const uint32_t a[], int32_t m, const uint32_t b[]) {
+INLINE void m_multiply (uint64_t p[/* n + m */], int32_t n, const uint64_t a[], int32_t m, const uint64_t b[]) {
     int32_t i, j;
-    uint64_t f, g;
-    memset (p, 0, (n + m) * sizeof (uint32_t));
+    uint128_t f, g;
+    memset (p, 0, (n + m) * sizeof (uint64_t));
     for (i = 0; i < m; i++) {
-        f = (uint64_t) b[i];
-        g = (uint64_t) 0;
+        f = (uint128_t) b[i];
+        g = (uint128_t) 0;
         for (j = 0; j < n; j++) {
-            g += f * (uint64_t) a[j] + p[i + j];
-            p[i + j] = MASK32(g);
-            g >>= 32;
+            g += f * (uint128_t) a[j] + p[i + j];
+            p[i + j] = MASK64(g);
+            g >>= 64;
         }
-        m_add_1 (p + i + j, (uint32_t) g);
+        p[i + j] = (uint64_t) g;  /* nothing was stored there yet */
     }
 }
 
@@ -388,17 +551,93 @@ INLINE void m_multiply (uint32_t p[/* n + m */], int32_t n, const uint32_t a[],
     Divides significand a by b yielding quotient q;
     returns the remainder;
     b must be nonzero!
-    using 64-bit arithmetic;
+    using 128-bit arithmetic;
 */
-INLINE uint32_t m_divide_1 (int32_t n, uint32_t q[], const uint32_t a[], uint32_t b) {
+INLINE uint64_t m_divide_1 (int32_t n, uint64_t q[], const uint64_t a[], uint64_t b) {
     int32_t i;
-    uint64_t f = 0, g = b;
-    for (i = n - 1; i >= 0; i--) {
-        f = (f << 32) + (uint64_t) a[i];
-        q[i] = (uint32_t)(f / g);
-        f %= g;
+    uint64_t f = 0;
+    for (i = n - 1; i >= 0; i--)
+        q[i] = div_128 (f, a[i], b, &f);
+    return f;
+}
+
+/*
+    Powers of ten up to 1e19 prepared for division by multiplication:
+    for the limbs of a longer dividend, the power shifted to have the
+    highest bit set, its div_2by1 reciprocal and the shift; for a single
+    limb dividend, the 65-bit magic multiplier (high bit separately) and
+    the post shift, Granlund, Montgomery: "Division by invariant integers
+    using multiplication" (1994)
+*/
+static const struct {
+    uint64_t d;
+    uint64_t v;
+    int32_t shift;
+    uint64_t m;
+    uint32_t mh;
+    int32_t post;
+} P_INV[] = {
+    {9223372036854775808u, 18446744073709551615u, 63, 0u, 1, 0},                  /* 1e0 */
+    {11529215046068469760u, 11068046444225730969u, 60, 14757395258967641293u, 0, 3},/* 1e1 */
+    {14411518807585587200u, 5165088340638674452u, 57, 5165088340638674453u, 1, 7},/* 1e2 */
+    {18014398509481984000u, 442721857769029238u, 54, 442721857769029239u, 1, 10}, /* 1e3 */
+    {11258999068426240000u, 11776401416656177751u, 50, 3777893186295716171u, 0, 11},/* 1e4 */
+    {14073748835532800000u, 5731772318583031878u, 47, 5731772318583031879u, 1, 17},/* 1e5 */
+    {17592186044416000000u, 896069040124515179u, 44, 4835703278458516699u, 0, 18},/* 1e6 */
+    {10995116277760000000u, 12501756908424955256u, 40, 15474250491067253437u, 0, 23},/* 1e7 */
+    {13743895347200000000u, 6312056711998053881u, 37, 12379400392853802749u, 0, 26},/* 1e8 */
+    {17179869184000000000u, 1360296554856532782u, 34, 1360296554856532783u, 1, 30},/* 1e9 */
+    {10737418240000000000u, 13244520931996183421u, 30, 15845632502852867519u, 0, 33},/* 1e10 */
+    {13421772800000000000u, 6906267930855036413u, 27, 12676506002282294015u, 0, 36},/* 1e11 */
+    {16777216000000000000u, 1835665529942118807u, 24, 2535301200456458803u, 0, 37},/* 1e12 */
+    {10485760000000000000u, 14005111292133121062u, 20, 4056481920730334085u, 0, 41},/* 1e13 */
+    {13107200000000000000u, 7514740218964586526u, 17, 811296384146066817u, 0, 42},/* 1e14 */
+    {16384000000000000000u, 2322443360429758898u, 14, 2322443360429758899u, 1, 50},/* 1e15 */
+    {10240000000000000000u, 14783955820913345206u, 10, 4153837486827862103u, 0, 51},/* 1e16 */
+    {12800000000000000000u, 8137815841988765842u, 7, 8137815841988765843u, 1, 57},/* 1e17 */
+    {16000000000000000000u, 2820903858849102350u, 4, 2820903858849102351u, 1, 60},/* 1e18 */
+    {10000000000000000000u, 15581492618384294730u, 0, 8507059173023461587u, 0, 62}/* 1e19 */
+};
+
+/* Divides a by 10 ** k, 0 <= k <= 19, using the magic multiplier */
+INLINE uint64_t div_pow10 (uint64_t a, int32_t k) {
+    uint128_t t = ((uint128_t) a * P_INV[k].m >> 64) + (uint128_t) a * P_INV[k].mh;
+    return (uint64_t)(t >> P_INV[k].post);
+}
+
+/*
+    Divides significand a by 10 ** k, 0 < k <= 19, yielding quotient q;
+    returns the remainder;
+    q and a may be the same;
+    using multiplication by the reciprocal, no division instruction;
+*/
+INLINE uint64_t m_divide_pow10 (int32_t n, uint64_t q[], const uint64_t a[], int32_t k) {
+    const uint64_t d = P_INV[k].d, v = P_INV[k].v;
+    const int32_t s = P_INV[k].shift;
+    uint64_t r = 0;
+    int32_t i;
+
+    /* leading zero limbs have zero quotient limbs */
+    for (; (n > 1) && (a[n - 1] == 0); n--) q[n - 1] = 0;
+
+    if (n == 1) {
+        r = a[0];
+        q[0] = div_pow10 (r, k);
+        return r - q[0] * P[k][0];
     }
-    return (uint32_t) f;
+
+    if (s == 0) {
+        for (i = n - 1; i >= 0; i--)
+            q[i] = div_2by1 (r, a[i], d, v, &r);
+        return r;
+    }
+
+    /* the dividend is shifted like the divisor on the fly */
+    r = a[n - 1] >> (64 - s);
+    for (i = n - 1; i > 0; i--)
+        q[i] = div_2by1 (r, a[i] << s | a[i - 1] >> (64 - s), d, v, &r);
+    q[0] = div_2by1 (r, a[0] << s, d, v, &r);
+    return r >> s;
 }
 
 /*
@@ -409,12 +648,13 @@ INLINE uint32_t m_divide_1 (int32_t n, uint32_t q[], const uint32_t a[], uint32_
     2 - exactly half of the least significant unit truncated
     3 - more than half of the least significant unit truncated
 */
-INLINE void dsr (int32_t n, uint32_t a[], int32_t shift, int32_t *t_flag) {
-    uint32_t remainder, divisor;
+INLINE void dsr (int32_t n, uint64_t a[], int32_t shift, int32_t *t_flag) {
+    uint64_t remainder, divisor;
     int32_t shift1;
     for (; shift > 0; shift -= shift1) {
-        shift1 = 9 <= shift ? 9 : shift;
-        remainder = m_divide_1 (n, a, a, divisor = P[shift1][0]);
+        shift1 = MAX_LIMB_DIGITS <= shift ? MAX_LIMB_DIGITS : shift;
+        remainder = m_divide_pow10 (n, a, a, shift1);
+        divisor = P[shift1][0];
         if (remainder < divisor / 2) {
             if (remainder || *t_flag) *t_flag = 1;
         } else if ((remainder > divisor / 2) || *t_flag) *t_flag = 3;
@@ -427,8 +667,8 @@ INLINE void dsr (int32_t n, uint32_t a[], int32_t shift, int32_t *t_flag) {
     ea and eb are exponents;
     ta and tb are truncate flags like above;
 */
-INLINE void make_comparable (uint32_t a[4], int32_t *ea, int32_t *ta, uint32_t b[4], int32_t *eb, int32_t *tb) {
-    uint32_t *c;
+INLINE void make_comparable (uint64_t a[3], int32_t *ea, int32_t *ta, uint64_t b[3], int32_t *eb, int32_t *tb) {
+    uint64_t *c;
     int32_t *p;
     int32_t shift, shift1;
 
@@ -455,13 +695,13 @@ INLINE void make_comparable (uint32_t a[4], int32_t *ea, int32_t *ta, uint32_t b
     /* (*ea > *eb) */
 
     /* decimally shift a to the left */
-    if (m_is_zero (3, a)) {
+    if (m_is_zero (2, a)) {
         *ea = *eb;
         return;
     }
     shift1 = max_shift_left (a) + 1;
     shift = *ea - *eb;
-    dsl (3, a, shift1 = shift1 < shift ? shift1 : shift);
+    dsl (2, a, shift1 = shift1 < shift ? shift1 : shift);
     *ea -= shift1;
 
     /* decimally shift b to the right if necessary */
@@ -469,97 +709,331 @@ INLINE void make_comparable (uint32_t a[4], int32_t *ea, int32_t *ta, uint32_t b
     if (!shift) return;
     if (shift > 26) {
         /* significand underflow */
-        if (!m_is_zero (3, b)) *tb = 1;
-        memset (b, 0, 3 * sizeof (uint32_t));
+        if (!m_is_zero (2, b)) *tb = 1;
+        memset (b, 0, 2 * sizeof (uint64_t));
         *eb = *ea;
         return;
     }
-    dsr (3, b, shift, tb);
+    dsr (2, b, shift, tb);
     *eb = *ea;
 }
 
+/*
+    Three-way comparison, -1 means a < b, 0 means a = b, 1 means a > b;
+    the decimal magnitudes, exponent plus digit count, decide when they
+    differ; otherwise the significand with the higher exponent has fewer
+    digits, so it is decimally shifted left exactly, staying below 1e26;
+*/
+int32_t deci_compare (deci a, deci b) {
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0}, sb[] = {M_LO(b), M_HI(b), 0};
+    int32_t sign = a.s ? -1 : 1, ma, mb;
+
+    /* zero has no sign */
+    if (m_is_zero (2, sa)) return m_is_zero (2, sb) ? 0 : (b.s ? 1 : -1);
+    if (m_is_zero (2, sb) || (a.s != b.s)) return sign;
+
+    if (a.e != b.e) {
+        ma = a.e + m_digits (sa);
+        mb = b.e + m_digits (sb);
+        if (ma != mb) return ma > mb ? sign : -sign;
+        if (a.e > b.e) dsl (2, sa, a.e - b.e);
+        else dsl (2, sb, b.e - a.e);
+    }
+    return sign * m_cmp (2, sa, sb);
+}
+
 bool deci_is_equal (deci a, deci b) {
-    int32_t ea = a.e, eb = b.e, ta, tb;
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0}, sb[] = {b.m0, b.m1, b.m2, 0};
+    return deci_compare (a, b) == 0;
+}
 
-    make_comparable (sa, &ea, &ta, sb, &eb, &tb);
+bool deci_is_lesser_or_equal (deci a, deci b) {
+    return deci_compare (a, b) <= 0;
+}
 
-    /* round */
-    if ((ta == 3) || ((ta == 2) && (sa[0] % 2 == 1))) m_add_1 (sa, 1);
-    else if ((tb == 3) || ((tb == 2) && (sb[0] % 2 == 1))) m_add_1 (sb, 1);
+/*
+    deci_compare (a, int_to_deci (b)); an integral a of one limb, the usual
+    case, is compared to |b| directly;
+*/
+int32_t deci_compare_int (deci a, int64_t b) {
+    uint64_t ua = M_LO(a), ub = b < 0 ? -(uint64_t) b : (uint64_t) b;
+    int32_t sign = a.s ? -1 : 1;
+
+    if ((a.e != 0) || (a.m2 != 0)) return deci_compare (a, int_to_deci (b));
 
-    return (m_cmp (3, sa, sb) == 0) && ((a.s == b.s) || m_is_zero (3, sa));
+    /* zero has no sign */
+    if (ua == 0) return b == 0 ? 0 : (b < 0 ? 1 : -1);
+    if ((b == 0) || (a.s != (b < 0))) return sign;
+    return ua == ub ? 0 : (ua > ub ? sign : -sign);
 }
 
-bool deci_is_lesser_or_equal (deci a, deci b) {
-    int32_t ea = a.e, eb = b.e, ta, tb;
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0}, sb[] = {b.m0, b.m1, b.m2, 0};
+/*
+    deci_compare (a, decimal_to_deci (b)), b compares as its shortest
+    decimal like in the conversion; a b of 1e153 or more in magnitude, which
+    the conversion would overflow on, is beyond every deci;
+*/
+int32_t deci_compare_decimal (deci a, double b) {
+    if (b >= 1e153) return -1;
+    if (b <= -1e153) return 1;
+    return deci_compare (a, decimal_to_deci (b));
+}
 
-    if (a.s && !b.s) return true;
-    if (!a.s && b.s) return m_is_zero(3, sa) && m_is_zero(3, sb);
+/*
+    Canonical form of deci a: the trailing decimal zeros of the significand
+    are removed as far as the exponent allows, and zero is nonnegative with
+    exponent zero; decis are equal iff their canonical forms are the same;
+    the zeros are stripped 16, 8, 4, 2 and 1 at a time;
+*/
+deci deci_canonical (deci a) {
+    uint64_t sa[] = {M_LO(a), M_HI(a)}, q[2];
+    int32_t e = a.e, k;
+
+    if (m_is_zero (2, sa)) return deci_zero;
+
+    for (k = 16; k > 0; k /= 2) {
+        /* 10 ** k is a multiple of 2 ** k, so test the low bits first */
+        if ((e + k > 127) || (sa[0] & (((uint64_t)1 << k) - 1))) continue;
+        if (m_divide_pow10 (2, q, sa, k) != 0) continue;
+        sa[0] = q[0];
+        sa[1] = q[1];
+        e += k;
+    }
+    m_to_deci (&a, sa);
+    a.e = e;
+    return a;
+}
 
-    make_comparable (sa, &ea, &ta, sb, &eb, &tb);
+/* Hash of deci a, the same for all equal decis, see deci_canonical */
+uint32_t deci_hash (deci a) {
+    deci c = deci_canonical (a);
+    uint64_t h = M_LO(c) * 0x9E3779B97F4A7C15u;
 
-    /* round */
-    if ((ta == 3) || ((ta == 2) && (sa[0] % 2 == 1))) m_add_1 (sa, 1);
-    else if ((tb == 3) || ((tb == 2) && (sb[0] % 2 == 1))) m_add_1 (sb, 1);
+    h ^= (M_HI(c) << 9 | (uint64_t)c.s << 8 | (uint8_t)c.e) * 0xC2B2AE3D27D4EB4Fu;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9u;
+    h ^= h >> 32;
+    return (uint32_t)h;
+}
 
-    return a.s ? (m_cmp (3, sa, sb) >= 0) : (m_cmp (3, sa, sb) <= 0);
+/*
+    Small-value tier of deci_add for significands that fit in 64 bits;
+    when the exponents differ by at most 18, the significand with the larger
+    exponent is decimally shifted left exactly, so no truncate flags arise;
+    a sum below 2 ** 64 is below 1e26 - 1 and needs no normalization either;
+    returns false on 64-bit overflow, the general path must be used then;
+*/
+INLINE bool add_small (deci *c, const deci a, const deci b) {
+    uint64_t sa = M_LO(a), sb = M_LO(b), sc;
+    int32_t e = a.e;
+
+    if (a.e > b.e) {
+        if (a.e - b.e > 18) return false;
+        if (__builtin_mul_overflow (sa, P[a.e - b.e][0], &sa)) return false;
+        e = b.e;
+    } else if (a.e < b.e) {
+        if (b.e - a.e > 18) return false;
+        if (__builtin_mul_overflow (sb, P[b.e - a.e][0], &sb)) return false;
+    }
+
+    c->s = a.s;
+    if (a.s == b.s) {
+        if (__builtin_add_overflow (sa, sb, &sc)) return false;
+    } else if (sa >= sb) sc = sa - sb;
+    else {
+        sc = sb - sa;
+        c->s = b.s;
+    }
+    c->m0 = (uint32_t)sc;
+    c->m1 = (uint32_t)(sc >> 32);
+    c->m2 = 0;
+    c->e = e;
+    return true;
 }
 
-deci deci_add (deci a, deci b) {
+#ifdef DECI_DECIMAL128
+
+/*
+    The _Decimal128 kernels, see [J];
+    a BID _Decimal128 is the coefficient in the low 113 bits, then the
+    biased exponent and the sign, for coefficients below 2 ** 113, and the
+    34-digit coefficients of canonical values always are;
+*/
+typedef _Decimal128 d128;
+
+#define BID_BIAS 6176
+
+INLINE d128 d128_from_parts (bool s, uint128_t c, int32_t e) {
+    uint128_t bits = c | (uint128_t)(e + BID_BIAS) << 113 | (uint128_t) s << 127;
+    d128 d;
+    memcpy (&d, &bits, sizeof (d));
+    return d;
+}
+
+INLINE uint128_t d128_to_parts (d128 d, bool *s, int32_t *e) {
+    uint128_t bits;
+    memcpy (&bits, &d, sizeof (bits));
+    *s = (bool)(bits >> 127);
+    *e = (int32_t)((bits >> 113) & 0x3FFF) - BID_BIAS;
+    return bits & (((uint128_t) 1 << 113) - 1);
+}
+
+/* 10 ** i modulo 2 ** 128 */
+INLINE uint128_t pow10_128 (int32_t i) {
+    uint128_t p = 1, p26 = (uint128_t) P[26][1] << 64 | P[26][0];
+    for (; i > 26; i -= 26) p *= p26;
+    return p * ((uint128_t) P[i][1] << 64 | P[i][0]);
+}
+
+/* Counts the decimal digits of c, 0 for 0 */
+INLINE int32_t digits_128 (uint128_t c) {
+    int32_t d = 0;
+    for (; c >= ((uint128_t) 1 << 64); d += MAX_LIMB_DIGITS) c /= P[MAX_LIMB_DIGITS][0];
+    for (; (d < 39) && (c >= P[1][0]); d++) c /= 10;
+    return c ? d + 1 : d;
+}
+
+/*
+    deci_add with _Decimal128 arithmetic;
+    the operand with the lower leading digit is cut to the digit 29 places
+    below the other one's leading digit, rounding to odd, so the sum is
+    exact in 34 digits; the rounding to 26 digits cuts at least two digits
+    more, and the odd last digit rounds it as the exact sum would;
+*/
+ALWAYS_INLINE deci add_deci (deci a, deci b, uint32_t *st) {
+    deci c;
+    bool s;
+    uint128_t ca = (uint128_t) M_HI(a) << 64 | M_LO(a), cb = (uint128_t) M_HI(b) << 64 | M_LO(b);
+    uint128_t cx = ca, cy = cb, t, p;
+    int32_t ex = a.e, ey = b.e, ta = a.e + digits_128 (ca), tb = b.e + digits_128 (cb);
+    int32_t e, cut, shift, tc = 0;
+    bool sx = a.s, sy = b.s;
+    uint64_t sc[4];
+
+    /* x is the operand with the higher leading digit */
+    if ((ca == 0) || ((cb != 0) && (tb > ta))) {
+        cx = cb;
+        cy = ca;
+        ex = b.e;
+        ey = a.e;
+        sx = b.s;
+        sy = a.s;
+        ta = tb;
+    }
+
+    /* cut y, rounding to odd */
+    cut = ta - 29 - ey;
+    if ((cy != 0) && (cut > 0)) {
+        if (cut > 38) cy = 1;
+        else {
+            p = pow10_128 (cut);
+            t = cy / p;
+            cy = (t * p == cy) ? t : t | 1;
+        }
+        ey += cut;
+    }
+
+    t = d128_to_parts (d128_from_parts (sx, cx, ex) + d128_from_parts (sy, cy, ey), &s, &e);
+    c.s = (t == 0) ? a.s : s;
+
+    /* round to 26 digits */
+    sc[0] = MASK64(t);
+    sc[1] = (uint64_t)(t >> 64);
+    sc[2] = 0;
+    sc[3] = 0;
+    shift = min_shift_right (sc);
+    if (shift > 0) {
+        dsr (2, sc, shift, &tc);
+        e += shift;
+        if ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) m_add_1 (sc, 1);
+    }
+    if (e > 127) {
+        raise_status (st, DECI_OVERFLOW);
+        return deci_zero;
+    }
+
+    if (st && tc) *st |= DECI_INEXACT;
+    m_to_deci (&c, sc);
+    c.e = e;
+    return c;
+}
+
+#else
+
+ALWAYS_INLINE deci add_deci (deci a, deci b, uint32_t *st) {
     deci c;
-    uint32_t sc[4];
+    uint64_t sc[3];
     int32_t ea = a.e, eb = b.e, ta, tb, tc, test;
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0}, sb[] = {b.m0, b.m1, b.m2, 0};
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0}, sb[] = {M_LO(b), M_HI(b), 0};
+
+    if ((a.m2 == 0) && (b.m2 == 0) && add_small (&c, a, b)) return c;
 
     make_comparable (sa, &ea, &ta, sb, &eb, &tb);
 
     c.s = a.s;
     if (a.s == b.s) {
         /* addition */
-        m_add (3, sc, sa, sb);
+        m_add (2, sc, sa, sb);
         tc = ta + tb;
-
-        /* significand normalization */
-        test = m_cmp (3, sc, P26_1);
-        if ((test > 0) || ((test == 0) && ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))))) {
-            if (ea == 127) OVERFLOW_ERROR;
-            ea++;
-            dsr (3, sc, 1, &tc);
-            /* the shift may be needed once again */
-            test = m_cmp (3, sc, P26_1);
-            if ((test > 0) || ((test == 0) && ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))))) {
-                if (ea == 127) OVERFLOW_ERROR;
-                ea++;
-                dsr (3, sc, 1, &tc);
-            }
-        }
-
-        /* round */
-        if ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) m_add_1 (sc, 1);
-
     } else {
         /* subtraction */
         tc = ta - tb;
-        if (m_subtract (3, sc, sa, sb)) {
-            m_negate (3, sc);
+        if (m_subtract (2, sc, sa, sb)) {
+            m_negate (2, sc);
             c.s = b.s;
             tc = -tc;
         }
-        /* round */
-        if ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) m_add_1 (sc, 1);
-        else if ((tc == -3) || ((tc == -2) && (sc[0] % 2 == 1))) m_subtract_1 (sc, 1);
+        /*
+            a negative flag means sc minus a fraction, that is sc - 1 plus
+            the complementary fraction; sc is not zero then, because only the
+            smaller operand can be truncated
+        */
+        if (tc < 0) {
+            m_subtract_1 (sc, 1);
+            tc += 4;
+        }
+    }
+
+    /*
+        significand normalization; make_comparable leaves up to 27 digits
+        in the operand with the higher exponent, so a difference may need it
+        as well as a sum
+    */
+    test = m_cmp (2, sc, P26_1);
+    if ((test > 0) || ((test == 0) && ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))))) {
+        if (ea == 127) {
+            raise_status (st, DECI_OVERFLOW);
+            return deci_zero;
+        }
+        ea++;
+        dsr (2, sc, 1, &tc);
+        /* the shift may be needed once again */
+        test = m_cmp (2, sc, P26_1);
+        if ((test > 0) || ((test == 0) && ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))))) {
+            if (ea == 127) {
+                raise_status (st, DECI_OVERFLOW);
+                return deci_zero;
+            }
+            ea++;
+            dsr (2, sc, 1, &tc);
+        }
     }
-    c.m0 = sc[0];
-    c.m1 = sc[1];
-    c.m2 = sc[2];
+
+    /* round */
+    if ((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) m_add_1 (sc, 1);
+
+    if (st && tc) *st |= DECI_INEXACT;
+    m_to_deci (&c, sc);
     c.e = ea;
     return c;
 }
 
+#endif
+
+deci deci_add (deci a, deci b) {
+    return add_deci (a, b, NULL);
+}
+
 deci deci_subtract (deci a, deci b) {
-    return deci_add (a, deci_negate (b));
+    return add_deci (a, deci_negate (b), NULL);
 }
 
 /* using 64-bit arithmetic */
@@ -575,23 +1049,23 @@ deci int_to_deci (int64_t a) {
 
 /* using 64-bit arithmetic */
 int64_t deci_to_int (const deci a) {
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0};
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0};
     int32_t ta;
     int64_t result;
 
     /* handle zero and small numbers */
-    if (m_is_zero (3, sa) || (a.e < -26)) return (int64_t) 0;
+    if (m_is_zero (2, sa) || (a.e < -26)) return (int64_t) 0;
 
     /* handle exponent */
     if (a.e >= 20) OVERFLOW_ERROR;
     if (a.e > 0)
-        if (m_cmp (3, P[20 - a.e], sa) <= 0) OVERFLOW_ERROR;
-        else dsl (3, sa, a.e);
-    else if (a.e < 0) dsr (3, sa, -a.e, &ta);
+        if (m_cmp (2, P[20 - a.e], sa) <= 0) OVERFLOW_ERROR;
+        else dsl (2, sa, a.e);
+    else if (a.e < 0) dsr (2, sa, -a.e, &ta);
 
     /* convert significand to integer */
-    if (m_cmp (3, sa, min_int64_t_as_deci) > 0) OVERFLOW_ERROR;
-    result = ((int64_t) sa[1] << 32) | (uint64_t) sa[0];
+    if (m_cmp (2, sa, min_int64_t_as_deci) > 0) OVERFLOW_ERROR;
+    result = (int64_t) sa[0];
 
     /* handle sign */
     if (a.s && result > INT64_MIN) result = -result;
@@ -600,33 +1074,894 @@ int64_t deci_to_int (const deci a) {
     return result;
 }
 
+/* powers of ten exactly representable as double */
+static const double P_DBL[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+    Powers of five 5^q for q in [-128; 134], the 128 most significant bits
+    (rounded up for q < 0), the high 64 bits first; see Lemire: "Number
+    Parsing at a Gigabyte per Second" (2021)
+*/
+#define P5_MIN -128
+static const uint64_t P5[][2] = {
+    {15983352577617880224u, 12429006944274865118u}, /* 5^-128 */
+    {9989595361011175140u, 7768129340171790699u},   /* 5^-127 */
+    {12486994201263968925u, 9710161675214738374u},  /* 5^-126 */
+    {15608742751579961156u, 16749388112445810871u}, /* 5^-125 */
+    {9755464219737475723u, 1244995533423855986u},   /* 5^-124 */
+    {12194330274671844653u, 15391302472061983695u}, /* 5^-123 */
+    {15242912843339805817u, 5404070034795315907u},  /* 5^-122 */
+    {9526820527087378635u, 14906758817815542202u},  /* 5^-121 */
+    {11908525658859223294u, 14021762503842039848u}, /* 5^-120 */
+    {14885657073574029118u, 8303831092947774002u},  /* 5^-119 */
+    {9303535670983768199u, 578208414664970847u},    /* 5^-118 */
+    {11629419588729710248u, 14557818573613377271u}, /* 5^-117 */
+    {14536774485912137810u, 18197273217016721589u}, /* 5^-116 */
+    {18170968107390172263u, 13523219484416126178u}, /* 5^-115 */
+    {11356855067118857664u, 15369541205401160717u}, /* 5^-114 */
+    {14196068833898572081u, 765182433041899281u},   /* 5^-113 */
+    {17745086042373215101u, 5568164059729762005u},  /* 5^-112 */
+    {11090678776483259438u, 5785945546544795205u},  /* 5^-111 */
+    {13863348470604074297u, 16455803970035769814u}, /* 5^-110 */
+    {17329185588255092872u, 6734696907262548556u},  /* 5^-109 */
+    {10830740992659433045u, 4209185567039092847u},  /* 5^-108 */
+    {13538426240824291306u, 9873167977226253963u},  /* 5^-107 */
+    {16923032801030364133u, 3118087934678041646u},  /* 5^-106 */
+    {10576895500643977583u, 4254647968387469981u},  /* 5^-105 */
+    {13221119375804971979u, 706623942056949572u},   /* 5^-104 */
+    {16526399219756214973u, 14718337982853350677u}, /* 5^-103 */
+    {10328999512347634358u, 11504804248497038125u}, /* 5^-102 */
+    {12911249390434542948u, 5157633273766521849u},  /* 5^-101 */
+    {16139061738043178685u, 6447041592208152311u},  /* 5^-100 */
+    {10086913586276986678u, 6335244004343789146u},  /* 5^-99 */
+    {12608641982846233347u, 17142427042284512241u}, /* 5^-98 */
+    {15760802478557791684u, 16816347784428252397u}, /* 5^-97 */
+    {9850501549098619803u, 1286845328412881940u},   /* 5^-96 */
+    {12313126936373274753u, 15443614715798266137u}, /* 5^-95 */
+    {15391408670466593442u, 5469460339465668959u},  /* 5^-94 */
+    {9619630419041620901u, 8030098730593431003u},   /* 5^-93 */
+    {12024538023802026126u, 14649309431669176658u}, /* 5^-92 */
+    {15030672529752532658u, 9088264752731695015u},  /* 5^-91 */
+    {9394170331095332911u, 10291851488884697288u},  /* 5^-90 */
+    {11742712913869166139u, 8253128342678483706u},  /* 5^-89 */
+    {14678391142336457674u, 5704724409920716729u},  /* 5^-88 */
+    {18347988927920572092u, 16354277549255671720u}, /* 5^-87 */
+    {11467493079950357558u, 998051431430019017u},   /* 5^-86 */
+    {14334366349937946947u, 10470936326142299579u}, /* 5^-85 */
+    {17917957937422433684u, 8476984389250486570u},  /* 5^-84 */
+    {11198723710889021052u, 14521487280136329914u}, /* 5^-83 */
+    {13998404638611276315u, 18151859100170412392u}, /* 5^-82 */
+    {17498005798264095394u, 18078137856785627587u}, /* 5^-81 */
+    {10936253623915059621u, 15910522178918405146u}, /* 5^-80 */
+    {13670317029893824527u, 6053094668365842720u},  /* 5^-79 */
+    {17087896287367280659u, 2954682317029915496u},  /* 5^-78 */
+    {10679935179604550411u, 17987577512639554849u}, /* 5^-77 */
+    {13349918974505688014u, 17872785872372055657u}, /* 5^-76 */
+    {16687398718132110018u, 13117610303610293764u}, /* 5^-75 */
+    {10429624198832568761u, 12810192458183821506u}, /* 5^-74 */
+    {13037030248540710952u, 2177682517447613171u},  /* 5^-73 */
+    {16296287810675888690u, 2722103146809516464u},  /* 5^-72 */
+    {10185179881672430431u, 6313000485183335694u},  /* 5^-71 */
+    {12731474852090538039u, 3279564588051781713u},  /* 5^-70 */
+    {15914343565113172548u, 17934513790346890853u}, /* 5^-69 */
+    {9946464728195732843u, 1985699082112030975u},   /* 5^-68 */
+    {12433080910244666053u, 16317181907922202431u}, /* 5^-67 */
+    {15541351137805832567u, 6561419329620589327u},  /* 5^-66 */
+    {9713344461128645354u, 11018416108653950185u},  /* 5^-65 */
+    {12141680576410806693u, 4549648098962661924u},  /* 5^-64 */
+    {15177100720513508366u, 10298746142130715309u}, /* 5^-63 */
+    {9485687950320942729u, 1825030320404309164u},   /* 5^-62 */
+    {11857109937901178411u, 6892973918932774359u},  /* 5^-61 */
+    {14821387422376473014u, 4004531380238580045u},  /* 5^-60 */
+    {9263367138985295633u, 16337890167931276240u},  /* 5^-59 */
+    {11579208923731619542u, 6587304654631931588u},  /* 5^-58 */
+    {14474011154664524427u, 17457502855144690293u}, /* 5^-57 */
+    {18092513943330655534u, 17210192550503474962u}, /* 5^-56 */
+    {11307821214581659709u, 6144684325637283947u},  /* 5^-55 */
+    {14134776518227074636u, 12292541425473992838u}, /* 5^-54 */
+    {17668470647783843295u, 15365676781842491048u}, /* 5^-53 */
+    {11042794154864902059u, 16521077016292638761u}, /* 5^-52 */
+    {13803492693581127574u, 16039660251938410547u}, /* 5^-51 */
+    {17254365866976409468u, 10826203278068237376u}, /* 5^-50 */
+    {10783978666860255917u, 15989749085647424168u}, /* 5^-49 */
+    {13479973333575319897u, 6152128301777116498u},  /* 5^-48 */
+    {16849966666969149871u, 12301846395648783526u}, /* 5^-47 */
+    {10531229166855718669u, 14606183024921571560u}, /* 5^-46 */
+    {13164036458569648337u, 4422670725869800738u},  /* 5^-45 */
+    {16455045573212060421u, 10140024425764638826u}, /* 5^-44 */
+    {10284403483257537763u, 8643358275316593218u},  /* 5^-43 */
+    {12855504354071922204u, 6192511825718353619u},  /* 5^-42 */
+    {16069380442589902755u, 7740639782147942024u},  /* 5^-41 */
+    {10043362776618689222u, 2532056854628769813u},  /* 5^-40 */
+    {12554203470773361527u, 12388443105140738074u}, /* 5^-39 */
+    {15692754338466701909u, 10873867862998534689u}, /* 5^-38 */
+    {9807971461541688693u, 9102010423587778132u},   /* 5^-37 */
+    {12259964326927110866u, 15989199047912110569u}, /* 5^-36 */
+    {15324955408658888583u, 10763126773035362404u}, /* 5^-35 */
+    {9578097130411805364u, 13644483260788183358u},  /* 5^-34 */
+    {11972621413014756705u, 17055604075985229198u}, /* 5^-33 */
+    {14965776766268445882u, 7484447039699372786u},  /* 5^-32 */
+    {9353610478917778676u, 9289465418239495895u},   /* 5^-31 */
+    {11692013098647223345u, 11611831772799369869u}, /* 5^-30 */
+    {14615016373309029182u, 679731660717048624u},   /* 5^-29 */
+    {18268770466636286477u, 10073036612751086588u}, /* 5^-28 */
+    {11417981541647679048u, 8601490892183123070u},  /* 5^-27 */
+    {14272476927059598810u, 10751863615228903838u}, /* 5^-26 */
+    {17840596158824498513u, 4216457482181353989u},  /* 5^-25 */
+    {11150372599265311570u, 14164500972431816003u}, /* 5^-24 */
+    {13937965749081639463u, 8482254178684994196u},  /* 5^-23 */
+    {17422457186352049329u, 5991131704928854841u},  /* 5^-22 */
+    {10889035741470030830u, 15273672361649004036u}, /* 5^-21 */
+    {13611294676837538538u, 9868718415206479237u},  /* 5^-20 */
+    {17014118346046923173u, 3112525982153323238u},  /* 5^-19 */
+    {10633823966279326983u, 4251171748059520976u},  /* 5^-18 */
+    {13292279957849158729u, 702278666647013315u},   /* 5^-17 */
+    {16615349947311448411u, 5489534351736154548u},  /* 5^-16 */
+    {10384593717069655257u, 1125115960621402641u},  /* 5^-15 */
+    {12980742146337069071u, 6018080969204141205u},  /* 5^-14 */
+    {16225927682921336339u, 2910915193077788602u},  /* 5^-13 */
+    {10141204801825835211u, 17960223060169475540u}, /* 5^-12 */
+    {12676506002282294014u, 17838592806784456521u}, /* 5^-11 */
+    {15845632502852867518u, 13074868971625794844u}, /* 5^-10 */
+    {9903520314283042199u, 3560107088838733873u},   /* 5^-9 */
+    {12379400392853802748u, 18285191916330581054u}, /* 5^-8 */
+    {15474250491067253436u, 4409745821703674701u},  /* 5^-7 */
+    {9671406556917033397u, 11979463175419572496u},  /* 5^-6 */
+    {12089258196146291747u, 1139270913992301908u},  /* 5^-5 */
+    {15111572745182864683u, 15259146697772541097u}, /* 5^-4 */
+    {9444732965739290427u, 7231123676894144234u},   /* 5^-3 */
+    {11805916207174113034u, 4427218577690292388u},  /* 5^-2 */
+    {14757395258967641292u, 14757395258967641293u}, /* 5^-1 */
+    {9223372036854775808u, 0u},                     /* 5^0 */
+    {11529215046068469760u, 0u},                    /* 5^1 */
+    {14411518807585587200u, 0u},                    /* 5^2 */
+    {18014398509481984000u, 0u},                    /* 5^3 */
+    {11258999068426240000u, 0u},                    /* 5^4 */
+    {14073748835532800000u, 0u},                    /* 5^5 */
+    {17592186044416000000u, 0u},                    /* 5^6 */
+    {10995116277760000000u, 0u},                    /* 5^7 */
+    {13743895347200000000u, 0u},                    /* 5^8 */
+    {17179869184000000000u, 0u},                    /* 5^9 */
+    {10737418240000000000u, 0u},                    /* 5^10 */
+    {13421772800000000000u, 0u},                    /* 5^11 */
+    {16777216000000000000u, 0u},                    /* 5^12 */
+    {10485760000000000000u, 0u},                    /* 5^13 */
+    {13107200000000000000u, 0u},                    /* 5^14 */
+    {16384000000000000000u, 0u},                    /* 5^15 */
+    {10240000000000000000u, 0u},                    /* 5^16 */
+    {12800000000000000000u, 0u},                    /* 5^17 */
+    {16000000000000000000u, 0u},                    /* 5^18 */
+    {10000000000000000000u, 0u},                    /* 5^19 */
+    {12500000000000000000u, 0u},                    /* 5^20 */
+    {15625000000000000000u, 0u},                    /* 5^21 */
+    {9765625000000000000u, 0u},                     /* 5^22 */
+    {12207031250000000000u, 0u},                    /* 5^23 */
+    {15258789062500000000u, 0u},                    /* 5^24 */
+    {9536743164062500000u, 0u},                     /* 5^25 */
+    {11920928955078125000u, 0u},                    /* 5^26 */
+    {14901161193847656250u, 0u},                    /* 5^27 */
+    {9313225746154785156u, 4611686018427387904u},   /* 5^28 */
+    {11641532182693481445u, 5764607523034234880u},  /* 5^29 */
+    {14551915228366851806u, 11817445422220181504u}, /* 5^30 */
+    {18189894035458564758u, 5548434740920451072u},  /* 5^31 */
+    {11368683772161602973u, 17302829768357445632u}, /* 5^32 */
+    {14210854715202003717u, 7793479155164643328u},  /* 5^33 */
+    {17763568394002504646u, 14353534962383192064u}, /* 5^34 */
+    {11102230246251565404u, 4359273333062107136u},  /* 5^35 */
+    {13877787807814456755u, 5449091666327633920u},  /* 5^36 */
+    {17347234759768070944u, 2199678564482154496u},  /* 5^37 */
+    {10842021724855044340u, 1374799102801346560u},  /* 5^38 */
+    {13552527156068805425u, 1718498878501683200u},  /* 5^39 */
+    {16940658945086006781u, 6759809616554491904u},  /* 5^40 */
+    {10587911840678754238u, 6530724019560251392u},  /* 5^41 */
+    {13234889800848442797u, 17386777061305090048u}, /* 5^42 */
+    {16543612251060553497u, 7898413271349198848u},  /* 5^43 */
+    {10339757656912845935u, 16465723340661719040u}, /* 5^44 */
+    {12924697071141057419u, 15970468157399760896u}, /* 5^45 */
+    {16155871338926321774u, 15351399178322313216u}, /* 5^46 */
+    {10097419586828951109u, 4982938468024057856u},  /* 5^47 */
+    {12621774483536188886u, 10840359103457460224u}, /* 5^48 */
+    {15777218104420236108u, 4327076842467049472u},  /* 5^49 */
+    {9860761315262647567u, 11927795063396681728u},  /* 5^50 */
+    {12325951644078309459u, 10298057810818464256u}, /* 5^51 */
+    {15407439555097886824u, 8260886245095692416u},  /* 5^52 */
+    {9629649721936179265u, 5163053903184807760u},   /* 5^53 */
+    {12037062152420224081u, 11065503397408397604u}, /* 5^54 */
+    {15046327690525280101u, 18443565265187884909u}, /* 5^55 */
+    {9403954806578300063u, 13833071299956122020u},  /* 5^56 */
+    {11754943508222875079u, 12679653106517764621u}, /* 5^57 */
+    {14693679385278593849u, 11237880364719817872u}, /* 5^58 */
+    {18367099231598242312u, 212292400617608628u},   /* 5^59 */
+    {11479437019748901445u, 132682750386005392u},   /* 5^60 */
+    {14349296274686126806u, 4777539456409894645u},  /* 5^61 */
+    {17936620343357658507u, 15195296357367144114u}, /* 5^62 */
+    {11210387714598536567u, 7191217214140771119u},  /* 5^63 */
+    {14012984643248170709u, 4377335499248575995u},  /* 5^64 */
+    {17516230804060213386u, 10083355392488107898u}, /* 5^65 */
+    {10947644252537633366u, 10913783138732455340u}, /* 5^66 */
+    {13684555315672041708u, 4418856886560793367u},  /* 5^67 */
+    {17105694144590052135u, 5523571108200991709u},  /* 5^68 */
+    {10691058840368782584u, 10369760970266701674u}, /* 5^69 */
+    {13363823550460978230u, 12962201212833377092u}, /* 5^70 */
+    {16704779438076222788u, 6979379479186945558u},  /* 5^71 */
+    {10440487148797639242u, 13585484211346616781u}, /* 5^72 */
+    {13050608935997049053u, 7758483227328495169u},  /* 5^73 */
+    {16313261169996311316u, 14309790052588006865u}, /* 5^74 */
+    {10195788231247694572u, 18166990819722280098u}, /* 5^75 */
+    {12744735289059618216u, 4261994450943298507u},  /* 5^76 */
+    {15930919111324522770u, 5327493063679123134u},  /* 5^77 */
+    {9956824444577826731u, 7941369183226839863u},   /* 5^78 */
+    {12446030555722283414u, 5315025460606161924u},  /* 5^79 */
+    {15557538194652854267u, 15867153862612478214u}, /* 5^80 */
+    {9723461371658033917u, 7611128154919104931u},   /* 5^81 */
+    {12154326714572542396u, 14125596212076269068u}, /* 5^82 */
+    {15192908393215677995u, 17656995265095336336u}, /* 5^83 */
+    {9495567745759798747u, 8729779031470891258u},   /* 5^84 */
+    {11869459682199748434u, 6300537770911226168u},  /* 5^85 */
+    {14836824602749685542u, 17099044250493808518u}, /* 5^86 */
+    {9273015376718553464u, 6075216638131242420u},   /* 5^87 */
+    {11591269220898191830u, 7594020797664053025u},  /* 5^88 */
+    {14489086526122739788u, 269153960225290473u},   /* 5^89 */
+    {18111358157653424735u, 336442450281613091u},   /* 5^90 */
+    {11319598848533390459u, 7127805559067090038u},  /* 5^91 */
+    {14149498560666738074u, 4298070930406474644u},  /* 5^92 */
+    {17686873200833422592u, 14595960699862869113u}, /* 5^93 */
+    {11054295750520889120u, 9122475437414293195u},  /* 5^94 */
+    {13817869688151111400u, 11403094296767866494u}, /* 5^95 */
+    {17272337110188889250u, 14253867870959833118u}, /* 5^96 */
+    {10795210693868055781u, 13520353437777283602u}, /* 5^97 */
+    {13494013367335069727u, 3065383741939440791u},  /* 5^98 */
+    {16867516709168837158u, 17666787732706464701u}, /* 5^99 */
+    {10542197943230523224u, 6430056314514152534u},  /* 5^100 */
+    {13177747429038154030u, 8037570393142690668u},  /* 5^101 */
+    {16472184286297692538u, 823590954573587527u},   /* 5^102 */
+    {10295115178936057836u, 5126430365035880108u},  /* 5^103 */
+    {12868893973670072295u, 6408037956294850135u},  /* 5^104 */
+    {16086117467087590369u, 3398361426941174765u},  /* 5^105 */
+    {10053823416929743980u, 13653190937906703988u}, /* 5^106 */
+    {12567279271162179975u, 17066488672383379985u}, /* 5^107 */
+    {15709099088952724969u, 16721424822051837077u}, /* 5^108 */
+    {9818186930595453106u, 3533361486141316317u},   /* 5^109 */
+    {12272733663244316382u, 13640073894531421205u}, /* 5^110 */
+    {15340917079055395478u, 7826720331309500698u},  /* 5^111 */
+    {9588073174409622174u, 280014188641050032u},    /* 5^112 */
+    {11985091468012027717u, 9573389772656088348u},  /* 5^113 */
+    {14981364335015034646u, 16578423234247498339u}, /* 5^114 */
+    {9363352709384396654u, 5749828502977298558u},   /* 5^115 */
+    {11704190886730495817u, 16410657665576399005u}, /* 5^116 */
+    {14630238608413119772u, 6678264026688335045u},  /* 5^117 */
+    {18287798260516399715u, 8347830033360418806u},  /* 5^118 */
+    {11429873912822749822u, 2911550761636567802u},  /* 5^119 */
+    {14287342391028437277u, 12862810488900485560u}, /* 5^120 */
+    {17859177988785546597u, 2243455055843443238u},  /* 5^121 */
+    {11161986242990966623u, 3708002419115845976u},  /* 5^122 */
+    {13952482803738708279u, 23317005467419566u},    /* 5^123 */
+    {17440603504673385348u, 13864204312116438170u}, /* 5^124 */
+    {10900377190420865842u, 17888499731927549664u}, /* 5^125 */
+    {13625471488026082303u, 13137252628054661272u}, /* 5^126 */
+    {17031839360032602879u, 11809879766640938686u}, /* 5^127 */
+    {10644899600020376799u, 14298703881791668535u}, /* 5^128 */
+    {13306124500025470999u, 13261693833812197764u}, /* 5^129 */
+    {16632655625031838749u, 11965431273837859301u}, /* 5^130 */
+    {10395409765644899218u, 9784237555362356015u},  /* 5^131 */
+    {12994262207056124023u, 3006924907348169211u},  /* 5^132 */
+    {16242827758820155028u, 17593714189467375226u}, /* 5^133 */
+    {10151767349262596893u, 1772699331562333708u}   /* 5^134 */
+};
+
+/*
+    Computes the bits of the double (sign excluded) nearest to w * 10^q,
+    w nonzero, q in [-128; 134], ties to even, using the Eisel-Lemire
+    algorithm; the 128-bit power of five is enough for binary64, and the
+    decis never reach the subnormal or infinite range;
+*/
+INLINE uint64_t eisel_lemire (uint64_t w, int32_t q) {
+    const uint64_t *p = P5[q - P5_MIN];
+    uint128_t first, second;
+    uint64_t hi, lo, mantissa;
+    int32_t lz, upperbit, shift, power2;
+
+    lz = __builtin_clzll (w);
+    w <<= lz;
+
+    first = (uint128_t) w * p[0];
+    hi = (uint64_t)(first >> 64);
+    lo = MASK64(first);
+    if ((hi & 0x1FF) == 0x1FF) {
+        second = (uint128_t) w * p[1];
+        lo += (uint64_t)(second >> 64);
+        if ((uint64_t)(second >> 64) > lo) hi++;
+    }
+
+    upperbit = (int32_t)(hi >> 63);
+    shift = upperbit + 64 - 52 - 3;
+    mantissa = hi >> shift;
+    power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+    assert((power2 > 0) && (power2 < 0x7FF));
+
+    /* an exact halfway case can only happen for small q */
+    if ((lo <= 1) && (q >= -4) && (q <= 23) && ((mantissa & 3) == 1))
+        if ((mantissa << shift) == hi) mantissa &= ~(uint64_t) 1;
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= ((uint64_t) 2 << 52)) {
+        mantissa = (uint64_t) 1 << 52;
+        power2++;
+    }
+    mantissa &= ~((uint64_t) 1 << 52);
+    return mantissa | (uint64_t) power2 << 52;
+}
+
+/*
+    Shifts significand a with length n to the left by bits;
+    a must be longer than the complete result;
+    returns the new length;
+*/
+INLINE int32_t m_shift_left (int32_t n, uint64_t a[], int32_t bits) {
+    int32_t i, limbs = bits / 64;
+    bits %= 64;
+    a[n + limbs] = 0;
+    for (i = n - 1; i >= 0; i--) {
+        if (bits) a[i + limbs + 1] |= a[i] >> (64 - bits);
+        a[i + limbs] = a[i] << bits;
+    }
+    for (i = 0; i < limbs; i++) a[i] = 0;
+    n += limbs + 1;
+    while ((n > 1) && (a[n - 1] == 0)) n--;
+    return n;
+}
+
+/* Multiplies significand a with length n by 5 ** k; returns the new length */
+INLINE int32_t m_multiply_pow5 (int32_t n, uint64_t a[], int32_t k) {
+    uint64_t f;
+    int32_t i, k1;
+    for (; k > 0; k -= k1) {
+        /* 5^27 is the greatest power of five fitting in 64 bits */
+        k1 = 27 <= k ? 27 : k;
+        for (f = 1, i = 0; i < k1; i++) f *= 5;
+        m_multiply_1 (n, a, a, f);
+        if (a[n] != 0) n++;
+    }
+    return n;
+}
+
+#define MAX_BIG 10
+
+/*
+    Compares significand m * 10^e with the double halfway between
+    the doubles with bits b and b + 1 (sign excluded), exactly;
+*/
+INLINE int32_t compare_halfway (const uint64_t m[2], int32_t e, uint64_t b) {
+    uint64_t x[MAX_BIG], y[MAX_BIG];
+    int32_t nx = m[1] ? 2 : 1, ny = 1, d;
+    int32_t be = (int32_t)(b >> 52) - 1023 - 52;  /* b is M * 2^be */
+
+    x[0] = m[0];
+    x[1] = m[1];
+    /* halfway is (2M + 1) * 2^(be - 1) */
+    y[0] = ((b & (((uint64_t) 1 << 52) - 1)) | ((uint64_t) 1 << 52)) * 2 + 1;
+
+    /* compare x * 5^e * 2^e with y * 2^(be - 1) */
+    if (e >= 0) nx = m_multiply_pow5 (nx, x, e);
+    else ny = m_multiply_pow5 (ny, y, -e);
+    d = e - (be - 1);
+    if (d > 0) nx = m_shift_left (nx, x, d);
+    else if (d < 0) ny = m_shift_left (ny, y, -d);
+
+    if (nx != ny) return nx < ny ? -1 : 1;
+    return m_cmp (nx, x, y);
+}
+
+/*
+    Converts deci a to the nearest double, ties to even;
+    small significands with small exponents use one exact double operation
+    (Clinger's fast path), others the Eisel-Lemire algorithm; a significand
+    longer than 19 digits is truncated to 19 digits for it, and when the
+    truncated and the incremented one round differently, the exact
+    comparison with the halfway point decides
+*/
 double deci_to_decimal (const deci a) {
-    /* use STRTOD */
-    char *se;
-    Byte b [34];
-    deci_to_string(b, a, 0, '.');
-    return strtod((char *)b, &se);
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0}, q[2], lo, hi;
+    int32_t e = a.e, j, c;
+    bool exact;
+    double d;
+
+    if (deci_is_zero (a)) return a.s ? -0.0 : 0.0;
+
+    if ((sa[1] == 0) && (sa[0] <= ((uint64_t) 1 << 53)) && (e >= -22) && (e <= 22)) {
+        d = e >= 0 ? (double) sa[0] * P_DBL[e] : (double) sa[0] / P_DBL[-e];
+        return a.s ? -d : d;
+    }
+
+    if (sa[1] == 0) lo = eisel_lemire (sa[0], e);
+    else {
+        /* keep the 19 most significant digits */
+        for (j = 1; m_cmp (2, sa, P[19 + j]) >= 0; j++) NOOP;
+        exact = (m_divide_pow10 (2, q, sa, j) == 0);
+        lo = eisel_lemire (q[0], e + j);
+        if (!exact) {
+            /* the value lies strictly between q and q + 1 */
+            hi = eisel_lemire (q[0] + 1, e + j);
+            if (hi != lo) {
+                c = compare_halfway (sa, e, lo);
+                if ((c > 0) || ((c == 0) && (lo & 1))) lo = hi;
+            }
+        }
+    }
+
+    lo |= (uint64_t) a.s << 63;
+    memcpy (&d, &lo, sizeof (d));
+    return d;
+}
+
+/*
+    Tables for the Ryu algorithm, see Adams: "Ryu: Fast Float-to-String
+    Conversion" (2018), the low 64 bits first; 2^k / 5^q rounded up and
+    5^q rounded down, both to 125 significant bits; they cover the doubles
+    from 2^-512 to 2^512, smaller ones round to zero and larger ones
+    overflow in the deci range
+*/
+#define RYU_BITS 125
+static const uint64_t RYU_POW5_INV[][2] = {
+    {1u, 2305843009213693952u},                      /* 5^-0 */
+    {11068046444225730970u, 1844674407370955161u},   /* 5^-1 */
+    {5165088340638674453u, 1475739525896764129u},    /* 5^-2 */
+    {7821419487252849886u, 1180591620717411303u},    /* 5^-3 */
+    {8824922364862649494u, 1888946593147858085u},    /* 5^-4 */
+    {7059937891890119595u, 1511157274518286468u},    /* 5^-5 */
+    {13026647942995916322u, 1208925819614629174u},   /* 5^-6 */
+    {9774590264567735146u, 1934281311383406679u},    /* 5^-7 */
+    {11509021026396098440u, 1547425049106725343u},   /* 5^-8 */
+    {16585914450600699399u, 1237940039285380274u},   /* 5^-9 */
+    {15469416676735388068u, 1980704062856608439u},   /* 5^-10 */
+    {16064882156130220778u, 1584563250285286751u},   /* 5^-11 */
+    {9162556910162266299u, 1267650600228229401u},    /* 5^-12 */
+    {7281393426775805432u, 2028240960365167042u},    /* 5^-13 */
+    {16893161185646375315u, 1622592768292133633u},   /* 5^-14 */
+    {2446482504291369283u, 1298074214633706907u},    /* 5^-15 */
+    {7603720821608101175u, 2076918743413931051u},    /* 5^-16 */
+    {2393627842544570617u, 1661534994731144841u},    /* 5^-17 */
+    {16672297533003297786u, 1329227995784915872u},   /* 5^-18 */
+    {11918280793837635165u, 2126764793255865396u},   /* 5^-19 */
+    {5845275820328197809u, 1701411834604692317u},    /* 5^-20 */
+    {15744267100488289217u, 1361129467683753853u},   /* 5^-21 */
+    {3054734472329800808u, 2177807148294006166u},    /* 5^-22 */
+    {17201182836831481939u, 1742245718635204932u},   /* 5^-23 */
+    {6382248639981364905u, 1393796574908163946u},    /* 5^-24 */
+    {2832900194486363201u, 2230074519853062314u},    /* 5^-25 */
+    {5955668970331000884u, 1784059615882449851u},    /* 5^-26 */
+    {1075186361522890384u, 1427247692705959881u},    /* 5^-27 */
+    {12788344622662355584u, 2283596308329535809u},   /* 5^-28 */
+    {13920024512871794791u, 1826877046663628647u},   /* 5^-29 */
+    {3757321980813615186u, 1461501637330902918u},    /* 5^-30 */
+    {10384555214134712795u, 1169201309864722334u},   /* 5^-31 */
+    {5547241898389809503u, 1870722095783555735u},    /* 5^-32 */
+    {4437793518711847602u, 1496577676626844588u},    /* 5^-33 */
+    {10928932444453298728u, 1197262141301475670u},   /* 5^-34 */
+    {17486291911125277965u, 1915619426082361072u},   /* 5^-35 */
+    {6610335899416401726u, 1532495540865888858u},    /* 5^-36 */
+    {12666966349016942027u, 1225996432692711086u},   /* 5^-37 */
+    {12888448528943286597u, 1961594292308337738u},   /* 5^-38 */
+    {17689456452638449924u, 1569275433846670190u},   /* 5^-39 */
+    {14151565162110759939u, 1255420347077336152u},   /* 5^-40 */
+    {7885109000409574610u, 2008672555323737844u},    /* 5^-41 */
+    {9997436015069570011u, 1606938044258990275u},    /* 5^-42 */
+    {7997948812055656009u, 1285550435407192220u},    /* 5^-43 */
+    {12796718099289049614u, 2056880696651507552u},   /* 5^-44 */
+    {2858676849947419045u, 1645504557321206042u},    /* 5^-45 */
+    {13354987924183666206u, 1316403645856964833u},   /* 5^-46 */
+    {17678631863951955605u, 2106245833371143733u},   /* 5^-47 */
+    {3074859046935833515u, 1684996666696914987u},    /* 5^-48 */
+    {13527933681774397782u, 1347997333357531989u},   /* 5^-49 */
+    {10576647446613305481u, 2156795733372051183u},   /* 5^-50 */
+    {15840015586774465031u, 1725436586697640946u},   /* 5^-51 */
+    {8982663654677661702u, 1380349269358112757u},    /* 5^-52 */
+    {18061610662226169046u, 2208558830972980411u},   /* 5^-53 */
+    {10759939715039024913u, 1766847064778384329u},   /* 5^-54 */
+    {12297300586773130254u, 1413477651822707463u},   /* 5^-55 */
+    {15986332124095098083u, 2261564242916331941u},   /* 5^-56 */
+    {9099716884534168143u, 1809251394333065553u},    /* 5^-57 */
+    {14658471137111155161u, 1447401115466452442u},   /* 5^-58 */
+    {4348079280205103483u, 1157920892373161954u},    /* 5^-59 */
+    {14335624477811986218u, 1852673427797059126u},   /* 5^-60 */
+    {7779150767507678651u, 1482138742237647301u},    /* 5^-61 */
+    {2533971799264232598u, 1185710993790117841u},    /* 5^-62 */
+    {15122401323048503126u, 1897137590064188545u},   /* 5^-63 */
+    {12097921058438802501u, 1517710072051350836u},   /* 5^-64 */
+    {5988988032009131678u, 1214168057641080669u},    /* 5^-65 */
+    {16961078480698431330u, 1942668892225729070u},   /* 5^-66 */
+    {13568862784558745064u, 1554135113780583256u},   /* 5^-67 */
+    {7165741412905085728u, 1243308091024466605u},    /* 5^-68 */
+    {11465186260648137165u, 1989292945639146568u},   /* 5^-69 */
+    {16550846638002330379u, 1591434356511317254u},   /* 5^-70 */
+    {16930026125143774626u, 1273147485209053803u},   /* 5^-71 */
+    {4951948911778577463u, 2037035976334486086u},    /* 5^-72 */
+    {272210314680951647u, 1629628781067588869u},     /* 5^-73 */
+    {3907117066486671641u, 1303703024854071095u},    /* 5^-74 */
+    {6251387306378674625u, 2085924839766513752u},    /* 5^-75 */
+    {16069156289328670670u, 1668739871813211001u},   /* 5^-76 */
+    {9165976216721026213u, 1334991897450568801u},    /* 5^-77 */
+    {7286864317269821294u, 2135987035920910082u},    /* 5^-78 */
+    {16897537898041588005u, 1708789628736728065u},   /* 5^-79 */
+    {13518030318433270404u, 1367031702989382452u},   /* 5^-80 */
+    {6871453250525591353u, 2187250724783011924u},    /* 5^-81 */
+    {9186511415162383406u, 1749800579826409539u},    /* 5^-82 */
+    {11038557946871817048u, 1399840463861127631u},   /* 5^-83 */
+    {10282995085511086630u, 2239744742177804210u},   /* 5^-84 */
+    {8226396068408869304u, 1791795793742243368u},    /* 5^-85 */
+    {13959814484210916090u, 1433436634993794694u},   /* 5^-86 */
+    {11267656730511734774u, 2293498615990071511u},   /* 5^-87 */
+    {5324776569667477496u, 1834798892792057209u},    /* 5^-88 */
+    {7949170070475892320u, 1467839114233645767u},    /* 5^-89 */
+    {17427382500606444826u, 1174271291386916613u},   /* 5^-90 */
+    {5747719112518849781u, 1878834066219066582u},    /* 5^-91 */
+    {15666221734240810795u, 1503067252975253265u},   /* 5^-92 */
+    {12532977387392648636u, 1202453802380202612u},   /* 5^-93 */
+    {5295368560860596524u, 1923926083808324180u},    /* 5^-94 */
+    {4236294848688477220u, 1539140867046659344u},    /* 5^-95 */
+    {7078384693692692099u, 1231312693637327475u},    /* 5^-96 */
+    {11325415509908307358u, 1970100309819723960u},   /* 5^-97 */
+    {9060332407926645887u, 1576080247855779168u},    /* 5^-98 */
+    {14626963555825137356u, 1260864198284623334u},   /* 5^-99 */
+    {12335095245094488799u, 2017382717255397335u},   /* 5^-100 */
+    {9868076196075591040u, 1613906173804317868u},    /* 5^-101 */
+    {15273158586344293478u, 1291124939043454294u},   /* 5^-102 */
+    {13369007293925138595u, 2065799902469526871u},   /* 5^-103 */
+    {7005857020398200553u, 1652639921975621497u},    /* 5^-104 */
+    {16672732060544291412u, 1322111937580497197u},   /* 5^-105 */
+    {11918976037903224966u, 2115379100128795516u},   /* 5^-106 */
+    {5845832015580669650u, 1692303280103036413u},    /* 5^-107 */
+    {12055363241948356366u, 1353842624082429130u},   /* 5^-108 */
+    {841837113407818570u, 2166148198531886609u},     /* 5^-109 */
+    {4362818505468165179u, 1732918558825509287u},    /* 5^-110 */
+    {14558301248600263113u, 1386334847060407429u},   /* 5^-111 */
+    {12225235553534690011u, 2218135755296651887u},   /* 5^-112 */
+    {2401490813343931363u, 1774508604237321510u},    /* 5^-113 */
+    {1921192650675145090u, 1419606883389857208u},    /* 5^-114 */
+    {17831303500047873437u, 2271371013423771532u},   /* 5^-115 */
+    {6886345170554478103u, 1817096810739017226u},    /* 5^-116 */
+    {1819727321701672159u, 1453677448591213781u},    /* 5^-117 */
+    {16213177116328979020u, 1162941958872971024u},   /* 5^-118 */
+    {14873036941900635463u, 1860707134196753639u},   /* 5^-119 */
+    {15587778368262418694u, 1488565707357402911u},   /* 5^-120 */
+    {8780873879868024632u, 1190852565885922329u},    /* 5^-121 */
+    {2981351763563108441u, 1905364105417475727u},    /* 5^-122 */
+    {13453127855076217722u, 1524291284333980581u},   /* 5^-123 */
+    {7073153469319063855u, 1219433027467184465u},    /* 5^-124 */
+    {11317045550910502167u, 1951092843947495144u},   /* 5^-125 */
+    {12742985255470312057u, 1560874275157996115u},   /* 5^-126 */
+    {10194388204376249646u, 1248699420126396892u},   /* 5^-127 */
+    {1553625868034358140u, 1997919072202235028u},    /* 5^-128 */
+    {8621598323911307159u, 1598335257761788022u},    /* 5^-129 */
+    {17965325103354776697u, 1278668206209430417u},   /* 5^-130 */
+    {13987124906400001422u, 2045869129935088668u},   /* 5^-131 */
+    {121653480894270168u, 1636695303948070935u},     /* 5^-132 */
+    {97322784715416134u, 1309356243158456748u},      /* 5^-133 */
+    {14913111714512307107u, 2094969989053530796u},   /* 5^-134 */
+    {8241140556867935363u, 1675975991242824637u},    /* 5^-135 */
+    {17660958889720079260u, 1340780792994259709u}    /* 5^-136 */
+};
+
+static const uint64_t RYU_POW5[][2] = {
+    {0u, 1152921504606846976u},                      /* 5^0 */
+    {0u, 1441151880758558720u},                      /* 5^1 */
+    {0u, 1801439850948198400u},                      /* 5^2 */
+    {0u, 2251799813685248000u},                      /* 5^3 */
+    {0u, 1407374883553280000u},                      /* 5^4 */
+    {0u, 1759218604441600000u},                      /* 5^5 */
+    {0u, 2199023255552000000u},                      /* 5^6 */
+    {0u, 1374389534720000000u},                      /* 5^7 */
+    {0u, 1717986918400000000u},                      /* 5^8 */
+    {0u, 2147483648000000000u},                      /* 5^9 */
+    {0u, 1342177280000000000u},                      /* 5^10 */
+    {0u, 1677721600000000000u},                      /* 5^11 */
+    {0u, 2097152000000000000u},                      /* 5^12 */
+    {0u, 1310720000000000000u},                      /* 5^13 */
+    {0u, 1638400000000000000u},                      /* 5^14 */
+    {0u, 2048000000000000000u},                      /* 5^15 */
+    {0u, 1280000000000000000u},                      /* 5^16 */
+    {0u, 1600000000000000000u},                      /* 5^17 */
+    {0u, 2000000000000000000u},                      /* 5^18 */
+    {0u, 1250000000000000000u},                      /* 5^19 */
+    {0u, 1562500000000000000u},                      /* 5^20 */
+    {0u, 1953125000000000000u},                      /* 5^21 */
+    {0u, 1220703125000000000u},                      /* 5^22 */
+    {0u, 1525878906250000000u},                      /* 5^23 */
+    {0u, 1907348632812500000u},                      /* 5^24 */
+    {0u, 1192092895507812500u},                      /* 5^25 */
+    {0u, 1490116119384765625u},                      /* 5^26 */
+    {4611686018427387904u, 1862645149230957031u},    /* 5^27 */
+    {9799832789158199296u, 1164153218269348144u},    /* 5^28 */
+    {12249790986447749120u, 1455191522836685180u},   /* 5^29 */
+    {15312238733059686400u, 1818989403545856475u},   /* 5^30 */
+    {14528612397897220096u, 2273736754432320594u},   /* 5^31 */
+    {13692068767113150464u, 1421085471520200371u},   /* 5^32 */
+    {12503399940464050176u, 1776356839400250464u},   /* 5^33 */
+    {15629249925580062720u, 2220446049250313080u},   /* 5^34 */
+    {9768281203487539200u, 1387778780781445675u},    /* 5^35 */
+    {7598665485932036096u, 1734723475976807094u},    /* 5^36 */
+    {274959820560269312u, 2168404344971008868u},     /* 5^37 */
+    {9395221924704944128u, 1355252715606880542u},    /* 5^38 */
+    {2520655369026404352u, 1694065894508600678u},    /* 5^39 */
+    {12374191248137781248u, 2117582368135750847u},   /* 5^40 */
+    {14651398557727195136u, 1323488980084844279u},   /* 5^41 */
+    {13702562178731606016u, 1654361225106055349u},   /* 5^42 */
+    {3293144668132343808u, 2067951531382569187u},    /* 5^43 */
+    {18199116482078572544u, 1292469707114105741u},   /* 5^44 */
+    {8913837547316051968u, 1615587133892632177u},    /* 5^45 */
+    {15753982952572452864u, 2019483917365790221u},   /* 5^46 */
+    {12152082354571476992u, 1262177448353618888u},   /* 5^47 */
+    {15190102943214346240u, 1577721810442023610u},   /* 5^48 */
+    {9764256642163156992u, 1972152263052529513u},    /* 5^49 */
+    {17631875447420442880u, 1232595164407830945u},   /* 5^50 */
+    {8204786253993389888u, 1540743955509788682u},    /* 5^51 */
+    {1032610780636961552u, 1925929944387235853u},    /* 5^52 */
+    {2951224747111794922u, 1203706215242022408u},    /* 5^53 */
+    {3689030933889743652u, 1504632769052528010u},    /* 5^54 */
+    {13834660704216955373u, 1880790961315660012u},   /* 5^55 */
+    {17870034976990372916u, 1175494350822287507u},   /* 5^56 */
+    {17725857702810578241u, 1469367938527859384u},   /* 5^57 */
+    {3710578054803671186u, 1836709923159824231u},    /* 5^58 */
+    {26536550077201078u, 2295887403949780289u},      /* 5^59 */
+    {11545800389866720434u, 1434929627468612680u},   /* 5^60 */
+    {14432250487333400542u, 1793662034335765850u},   /* 5^61 */
+    {8816941072311974870u, 2242077542919707313u},    /* 5^62 */
+    {17039803216263454053u, 1401298464324817070u},   /* 5^63 */
+    {12076381983474541759u, 1751623080406021338u},   /* 5^64 */
+    {5872105442488401391u, 2189528850507526673u},    /* 5^65 */
+    {15199280947623720629u, 1368455531567204170u},   /* 5^66 */
+    {9775729147674874978u, 1710569414459005213u},    /* 5^67 */
+    {16831347453020981627u, 2138211768073756516u},   /* 5^68 */
+    {1296220121283337709u, 1336382355046097823u},    /* 5^69 */
+    {15455333206886335848u, 1670477943807622278u},   /* 5^70 */
+    {10095794471753144002u, 2088097429759527848u},   /* 5^71 */
+    {6309871544845715001u, 1305060893599704905u},    /* 5^72 */
+    {12499025449484531656u, 1631326116999631131u},   /* 5^73 */
+    {11012095793428276666u, 2039157646249538914u},   /* 5^74 */
+    {11494245889320060820u, 1274473528905961821u},   /* 5^75 */
+    {532749306367912313u, 1593091911132452277u},     /* 5^76 */
+    {5277622651387278295u, 1991364888915565346u},    /* 5^77 */
+    {7910200175544436838u, 1244603055572228341u},    /* 5^78 */
+    {14499436237857933952u, 1555753819465285426u},   /* 5^79 */
+    {8900923260467641632u, 1944692274331606783u},    /* 5^80 */
+    {12480606065433357876u, 1215432671457254239u},   /* 5^81 */
+    {10989071563364309441u, 1519290839321567799u},   /* 5^82 */
+    {9124653435777998898u, 1899113549151959749u},    /* 5^83 */
+    {8008751406574943263u, 1186945968219974843u},    /* 5^84 */
+    {5399253239791291175u, 1483682460274968554u},    /* 5^85 */
+    {15972438586593889776u, 1854603075343710692u},   /* 5^86 */
+    {759402079766405302u, 1159126922089819183u},     /* 5^87 */
+    {14784310654990170340u, 1448908652612273978u},   /* 5^88 */
+    {9257016281882937117u, 1811135815765342473u},    /* 5^89 */
+    {16182956370781059300u, 2263919769706678091u},   /* 5^90 */
+    {7808504722524468110u, 1414949856066673807u},    /* 5^91 */
+    {5148944884728197234u, 1768687320083342259u},    /* 5^92 */
+    {1824495087482858639u, 2210859150104177824u},    /* 5^93 */
+    {1140309429676786649u, 1381786968815111140u},    /* 5^94 */
+    {1425386787095983311u, 1727233711018888925u},    /* 5^95 */
+    {6393419502297367043u, 2159042138773611156u},    /* 5^96 */
+    {13219259225790630210u, 1349401336733506972u},   /* 5^97 */
+    {16524074032238287762u, 1686751670916883715u},   /* 5^98 */
+    {16043406521870471799u, 2108439588646104644u},   /* 5^99 */
+    {803757039314269066u, 1317774742903815403u},     /* 5^100 */
+    {14839754354425000045u, 1647218428629769253u},   /* 5^101 */
+    {4714634887749086344u, 2059023035787211567u},    /* 5^102 */
+    {9864175832484260821u, 1286889397367007229u},    /* 5^103 */
+    {16941905809032713930u, 1608611746708759036u},   /* 5^104 */
+    {2730638187581340797u, 2010764683385948796u},    /* 5^105 */
+    {10930020904093113806u, 1256727927116217997u},   /* 5^106 */
+    {18274212148543780162u, 1570909908895272496u},   /* 5^107 */
+    {4396021111970173586u, 1963637386119090621u},    /* 5^108 */
+    {5053356204195052443u, 1227273366324431638u},    /* 5^109 */
+    {15540067292098591362u, 1534091707905539547u},   /* 5^110 */
+    {14813398096695851299u, 1917614634881924434u},   /* 5^111 */
+    {13870059828862294966u, 1198509146801202771u},   /* 5^112 */
+    {12725888767650480803u, 1498136433501503464u},   /* 5^113 */
+    {15907360959563101004u, 1872670541876879330u},   /* 5^114 */
+    {14553786618154326031u, 1170419088673049581u},   /* 5^115 */
+    {4357175217410743827u, 1463023860841311977u},    /* 5^116 */
+    {10058155040190817688u, 1828779826051639971u},   /* 5^117 */
+    {7961007781811134206u, 2285974782564549964u},    /* 5^118 */
+    {14199001900486734687u, 1428734239102843727u},   /* 5^119 */
+    {13137066357181030455u, 1785917798878554659u},   /* 5^120 */
+    {11809646928048900164u, 2232397248598193324u},   /* 5^121 */
+    {16604401366885338411u, 1395248280373870827u},   /* 5^122 */
+    {16143815690179285109u, 1744060350467338534u},   /* 5^123 */
+    {10956397575869330579u, 2180075438084173168u},   /* 5^124 */
+    {6847748484918331612u, 1362547148802608230u},    /* 5^125 */
+    {17783057643002690323u, 1703183936003260287u},   /* 5^126 */
+    {17617136035325974999u, 2128979920004075359u},   /* 5^127 */
+    {17928239049719816230u, 1330612450002547099u},   /* 5^128 */
+    {17798612793722382384u, 1663265562503183874u},   /* 5^129 */
+    {13024893955298202172u, 2079081953128979843u},   /* 5^130 */
+    {5834715712847682405u, 1299426220705612402u},    /* 5^131 */
+    {16516766677914378815u, 1624282775882015502u},   /* 5^132 */
+    {11422586310538197711u, 2030353469852519378u},   /* 5^133 */
+    {11750802462513761473u, 1268970918657824611u},   /* 5^134 */
+    {10076817059714813937u, 1586213648322280764u},   /* 5^135 */
+    {12596021324643517422u, 1982767060402850955u},   /* 5^136 */
+    {5566670318688504437u, 1239229412751781847u},    /* 5^137 */
+    {2346651879933242642u, 1549036765939727309u},    /* 5^138 */
+    {7545000868343941206u, 1936295957424659136u},    /* 5^139 */
+    {4715625542714963254u, 1210184973390411960u},    /* 5^140 */
+    {5894531928393704067u, 1512731216738014950u},    /* 5^141 */
+    {16591536947346905892u, 1890914020922518687u},   /* 5^142 */
+    {17287239619732898039u, 1181821263076574179u},   /* 5^143 */
+    {16997363506238734644u, 1477276578845717724u},   /* 5^144 */
+    {2799960309088866689u, 1846595723557147156u},    /* 5^145 */
+    {10973347230035317489u, 1154122327223216972u},   /* 5^146 */
+    {13716684037544146861u, 1442652909029021215u},   /* 5^147 */
+    {12534169028502795672u, 1803316136286276519u},   /* 5^148 */
+    {11056025267201106687u, 2254145170357845649u},   /* 5^149 */
+    {18439230838069161439u, 1408840731473653530u},   /* 5^150 */
+    {13825666510731675991u, 1761050914342066913u},   /* 5^151 */
+    {3447025083132431277u, 2201313642927583642u},    /* 5^152 */
+    {6766076695385157452u, 1375821026829739776u},    /* 5^153 */
+    {8457595869231446815u, 1719776283537174720u},    /* 5^154 */
+    {10571994836539308519u, 2149720354421468400u},   /* 5^155 */
+    {6607496772837067824u, 1343575221513417750u},    /* 5^156 */
+    {17482743002901110588u, 1679469026891772187u},   /* 5^157 */
+    {17241742735199000331u, 2099336283614715234u},   /* 5^158 */
+    {15387775227926763111u, 1312085177259197021u},   /* 5^159 */
+    {5399660979626290177u, 1640106471573996277u},    /* 5^160 */
+    {11361262242960250625u, 2050133089467495346u},   /* 5^161 */
+    {11712474920277544544u, 1281333180917184591u},   /* 5^162 */
+    {10028907631919542777u, 1601666476146480739u},   /* 5^163 */
+    {7924448521472040567u, 2002083095183100924u},    /* 5^164 */
+    {14176152362774801162u, 1251301934489438077u},   /* 5^165 */
+    {3885132398186337741u, 1564127418111797597u},    /* 5^166 */
+    {9468101516160310080u, 1955159272639746996u},    /* 5^167 */
+    {15140935484454969608u, 1221974545399841872u},   /* 5^168 */
+    {479425281859160394u, 1527468181749802341u},     /* 5^169 */
+    {5210967620751338397u, 1909335227187252926u},    /* 5^170 */
+    {17091912818251750210u, 1193334516992033078u},   /* 5^171 */
+    {12141518985959911954u, 1491668146240041348u}    /* 5^172 */
+};
+
+/* floor (log2 (5 ** e)) + 1 */
+INLINE int32_t pow5bits (int32_t e) {return ((e * 1217359) >> 19) + 1;}
+
+/* floor (log10 (2 ** e)) */
+INLINE int32_t log10_pow2 (int32_t e) {return (e * 78913) >> 18;}
+
+/* floor (log10 (5 ** e)) */
+INLINE int32_t log10_pow5 (int32_t e) {return (e * 732923) >> 20;}
+
+INLINE bool is_multiple_of_pow5 (uint64_t a, int32_t p) {
+    for (; (p > 0) && (a % 5 == 0); p--) a /= 5;
+    return p <= 0;
+}
+
+INLINE bool is_multiple_of_pow2 (uint64_t a, int32_t p) {
+    return (a & (((uint64_t) 1 << p) - 1)) == 0;
+}
+
+/* (m * mul) >> j, 64 < j */
+INLINE uint64_t mul_shift (uint64_t m, const uint64_t mul[2], int32_t j) {
+    uint128_t b0 = (uint128_t) m * mul[0], b2 = (uint128_t) m * mul[1];
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
 }
 
-#define DOUBLE_DIGITS 17
+/*
+    Computes the shortest decimal significand *d and exponent *e
+    reading back as the positive double with the given mantissa bits and
+    biased exponent, the nearest one when there are several;
+    ties choose the even significand;
+*/
+INLINE void ryu (uint64_t mantissa, int32_t exponent, uint64_t *d, int32_t *e) {
+    uint64_t m2, mv, vr, vp, vm, output;
+    int32_t e2, e10, q, i, removed = 0, last_removed = 0;
+    bool accept_bounds, vm_zeros = false, vr_zeros = false, round_up = false;
+    int32_t mm_shift = (mantissa != 0) || (exponent <= 1);
+
+    if (exponent == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = mantissa;
+    } else {
+        e2 = exponent - 1023 - 52 - 2;
+        m2 = ((uint64_t) 1 << 52) | mantissa;
+    }
+    accept_bounds = (m2 % 2 == 0);
+
+    /* the bounds of the interval reading back as the double, times 4 */
+    mv = 4 * m2;
+    if (e2 >= 0) {
+        q = log10_pow2 (e2) - (e2 > 3);
+        e10 = q;
+        i = -e2 + q + RYU_BITS + pow5bits (q) - 1;
+        vr = mul_shift (4 * m2, RYU_POW5_INV[q], i);
+        vp = mul_shift (4 * m2 + 2, RYU_POW5_INV[q], i);
+        vm = mul_shift (4 * m2 - 1 - mm_shift, RYU_POW5_INV[q], i);
+        if (q <= 21) {
+            if (mv % 5 == 0) vr_zeros = is_multiple_of_pow5 (mv, q);
+            else if (accept_bounds) vm_zeros = is_multiple_of_pow5 (mv - 1 - mm_shift, q);
+            else vp -= is_multiple_of_pow5 (mv + 2, q);
+        }
+    } else {
+        q = log10_pow5 (-e2) - (-e2 > 1);
+        e10 = q + e2;
+        i = -e2 - q;
+        q -= pow5bits (i) - RYU_BITS;
+        vr = mul_shift (4 * m2, RYU_POW5[i], q);
+        vp = mul_shift (4 * m2 + 2, RYU_POW5[i], q);
+        vm = mul_shift (4 * m2 - 1 - mm_shift, RYU_POW5[i], q);
+        q += pow5bits (i) - RYU_BITS;
+        if (q <= 1) {
+            vr_zeros = true;
+            if (accept_bounds) vm_zeros = (mm_shift == 1);
+            else vp--;
+        } else if (q < 63) vr_zeros = is_multiple_of_pow2 (mv, q);
+    }
+
+    /* remove the digits common to vm and vp */
+    if (vm_zeros || vr_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_zeros &= (vm % 10 == 0);
+            vr_zeros &= (last_removed == 0);
+            last_removed = (int32_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_zeros)
+            while (vm % 10 == 0) {
+                vr_zeros &= (last_removed == 0);
+                last_removed = (int32_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        /* round to even */
+        if (vr_zeros && (last_removed == 5) && (vr % 2 == 0)) last_removed = 4;
+        output = vr + (((vr == vm) && (!accept_bounds || !vm_zeros)) || (last_removed >= 5));
+    } else {
+        if (vp / 100 > vm / 100) {
+            round_up = (vr % 100 >= 50);
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = (vr % 10 >= 5);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + ((vr == vm) || round_up);
+    }
+
+    *d = output;
+    *e = e10 + removed;
+}
 
-/* using the dtoa function */
+/*
+    Converts double a to deci using its shortest decimal representation
+    reading back as a, the same digits as DTOA in mode 0 would produce
+*/
 deci decimal_to_deci (double a) {
     deci result;
-    int64_t d; /* decimal significand */
-    int e; /* decimal exponent */
-    int s; /* sign */
-    Byte* c;
-    Byte* rve;
+    uint64_t bits, d = 0; /* decimal significand */
+    int32_t e = 0; /* decimal exponent */
+    int32_t be;
 
-    /* convert a to string */
-    c = (Byte* ) dtoa (a, 0, DOUBLE_DIGITS, &e, &s, (char **) &rve);
+    memcpy (&bits, &a, sizeof (bits));
+    be = (int32_t)(bits >> 52) & 0x7FF;
 
-    e -= (rve - c);
+    /* doubles of 2^512 and more overflow */
+    if (be >= 1023 + 512) OVERFLOW_ERROR;
 
-    d = CHR_TO_INT(c);
+    /* doubles below 2^-512 have exponents below -154 and round to zero */
+    if (be >= 1023 - 512) ryu (bits & (((uint64_t) 1 << 52) - 1), be, &d, &e);
 
-    result.s = (s != 0);
+    result.s = (bits >> 63) != 0;
     result.m2 = 0;
     result.m1 = (uint32_t)(d >> 32);
     result.m0 = (uint32_t)d;
@@ -640,16 +1975,22 @@ deci decimal_to_deci (double a) {
     returns zero when underflow occurs;
     ta is a truncate flag as described above;
     *f is supposed to be in range [-128; 127];
+    reports overflow, inexact and underflow to status st, see raise_status;
 */
-INLINE void m_ldexp (uint32_t a[4], int32_t *f, int32_t e, int32_t ta) {
+INLINE void m_ldexp (uint64_t a[3], int32_t *f, int32_t e, int32_t ta, uint32_t *st) {
     /* take care of zero significand */
-    if (m_is_zero (3, a)) {
+    if (m_is_zero (2, a)) {
         *f = 0;
         return;
     }
 
     /* take care of exponent overflow */
-    if (e >= 281) OVERFLOW_ERROR;
+    if (e >= 281) {
+        raise_status (st, DECI_OVERFLOW);
+        memset (a, 0, 2 * sizeof (uint64_t));
+        *f = 0;
+        return;
+    }
     if (e < -281) e = -282;
 
     *f += e;
@@ -658,54 +1999,62 @@ INLINE void m_ldexp (uint32_t a[4], int32_t *f, int32_t e, int32_t ta) {
     if (*f < -128) {
         if (*f < -154) {
             /* underflow */
-            memset (a, 0, 3 * sizeof (uint32_t));
+            memset (a, 0, 2 * sizeof (uint64_t));
             *f = 0;
+            if (st) *st |= DECI_INEXACT | DECI_UNDERFLOW;
             return;
         }
         /* shift and round */
-        dsr (3, a, -128 - *f, &ta);
+        dsr (2, a, -128 - *f, &ta);
         *f = -128;
         if ((ta == 3) || ((ta == 2) && (a[0] % 2 == 1))) m_add_1 (a, 1);
+        if (st && ta) *st |= DECI_INEXACT | DECI_UNDERFLOW;
         return;
     }
 
     /* decimally shift the significand to the left if needed */
     if (*f > 127) {
-        if ((*f >= 153) || (m_cmp (3, P[153 - *f], a) <= 0)) OVERFLOW_ERROR;
-        dsl (3, a, *f - 127);
+        if ((*f >= 153) || (m_cmp (2, P[153 - *f], a) <= 0)) {
+            raise_status (st, DECI_OVERFLOW);
+            memset (a, 0, 2 * sizeof (uint64_t));
+            *f = 0;
+            return;
+        }
+        dsl (2, a, *f - 127);
         *f = 127;
     }
+    if (st && ta) *st |= DECI_INEXACT;
 }
 
-/* Calculates a * (10 ** e); returns zero when underflow occurs */
-deci deci_ldexp (deci a, int32_t e) {
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0};
+/* a * (10 ** e) reporting to status st, see raise_status() */
+INLINE deci ldexp_deci (deci a, int32_t e, uint32_t *st) {
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0};
     int32_t f = a.e;
 
-    m_ldexp (sa, &f, e, 0);
-    a.m0 = sa[0];
-    a.m1 = sa[1];
-    a.m2 = sa[2];
+    m_ldexp (sa, &f, e, 0, st);
+    m_to_deci (&a, sa);
     a.e = f;
     return a;
 }
 
+/* Calculates a * (10 ** e); returns zero when underflow occurs */
+deci deci_ldexp (deci a, int32_t e) {
+    return ldexp_deci (a, e, NULL);
+}
+
 #define denormalize \
     if (a.e >= b.e) return a; \
-    sa[0] = a.m0; \
-    sa[1] = a.m1; \
-    sa[2] = a.m2; \
-    dsr (3, sa, b.e - a.e, &ta); \
-    a.m0 = sa[0]; \
-    a.m1 = sa[1]; \
-    a.m2 = sa[2]; \
+    sa[0] = M_LO(a); \
+    sa[1] = M_HI(a); \
+    dsr (2, sa, b.e - a.e, &ta); \
+    m_to_deci (&a, sa); \
     a.e = b.e; \
     return a;
 
 /* truncate a to obtain a multiple of b */
 deci deci_truncate (deci a, deci b) {
     deci c;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -720,7 +2069,7 @@ deci deci_truncate (deci a, deci b) {
 /* round a away from zero to obtain a multiple of b */
 deci deci_away (deci a, deci b) {
     deci c;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -739,7 +2088,7 @@ deci deci_away (deci a, deci b) {
 /* round a down to obtain a multiple of b */
 deci deci_floor (deci a, deci b) {
     deci c;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -759,7 +2108,7 @@ deci deci_floor (deci a, deci b) {
 /* round a up to obtain a multiple of b */
 deci deci_ceil (deci a, deci b) {
     deci c;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -775,11 +2124,10 @@ deci deci_ceil (deci a, deci b) {
 
     denormalize
 }
-
 /* round a half even to obtain a multiple of b */
 deci deci_half_even (deci a, deci b) {
     deci c, d, e, f;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
     bool g;
 
@@ -814,7 +2162,7 @@ deci deci_half_even (deci a, deci b) {
 /* round a half away from zero to obtain a multiple of b */
 deci deci_half_away (deci a, deci b) {
     deci c, d;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -841,7 +2189,7 @@ deci deci_half_away (deci a, deci b) {
 /* round a half truncate to obtain a multiple of b */
 deci deci_half_truncate (deci a, deci b) {
     deci c, d;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -868,7 +2216,7 @@ deci deci_half_truncate (deci a, deci b) {
 /* round a half up to obtain a multiple of b */
 deci deci_half_ceil (deci a, deci b) {
     deci c, d;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -916,7 +2264,7 @@ deci deci_half_ceil (deci a, deci b) {
 /* round a half down to obtain a multiple of b */
 deci deci_half_floor (deci a, deci b) {
     deci c, d;
-    uint32_t sa[3];
+    uint64_t sa[2];
     int32_t ta = 0;
 
     c = deci_mod (a, b);
@@ -961,200 +2309,1363 @@ deci deci_half_floor (deci a, deci b) {
     denormalize
 }
 
-deci deci_multiply (const deci a, const deci b) {
+#ifdef DECI_DECIMAL128
+
+/*
+    Rounds significand t with exponent e to a deci with sign s, like
+    multiply_deci does; t may have up to 34 digits, tc is 1 if the exact
+    value has a fraction of the last digit of t, then t has 34 digits;
+*/
+INLINE deci d128_round (bool s, uint128_t t, int32_t tc, int32_t e, uint32_t *st) {
     deci c;
-    uint32_t sa[] = {a.m0, a.m1, a.m2}, sb[] = {b.m0, b.m1, b.m2}, sc[7];
+    uint64_t sc[] = {MASK64(t), (uint64_t)(t >> 64), 0, 0};
+    int32_t shift, f = 0;
+
+    c.s = s;
+    shift = min_shift_right (sc);
+    e += shift;
+    if (shift > 0) {
+        dsr (2, sc, shift, &tc);
+        if (((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) && (e >= -128)) m_add_1 (sc, 1);
+    }
+
+    m_ldexp (sc, &f, e, tc, st);
+    m_to_deci (&c, sc);
+    c.e = f;
+    return c;
+}
+
+/*
+    deci_multiply with _Decimal128 arithmetic;
+    a product of more than 34 digits is rounded, its residual modulo 2 ** 128
+    gives its sign as it is below half the last digit, so the product is
+    truncated with a fraction flag and rounded to 26 digits once;
+*/
+ALWAYS_INLINE deci multiply_deci (const deci a, const deci b, uint32_t *st) {
+    bool s;
+    uint128_t ca = (uint128_t) M_HI(a) << 64 | M_LO(a), cb = (uint128_t) M_HI(b) << 64 | M_LO(b);
+    uint128_t t, r;
+    int32_t k, tc = 0;
+
+    t = d128_to_parts (d128_from_parts (false, ca, 0) * d128_from_parts (false, cb, 0), &s, &k);
+    if (k > 0) {
+        r = ca * cb - t * (uint128_t) P[k][0];
+        if (r >> 127) t--;
+        tc = r != 0;
+    }
+
+    return d128_round ((!a.s && b.s) || (a.s && !b.s), t, tc, a.e + b.e + k, st);
+}
+
+#else
+
+ALWAYS_INLINE deci multiply_deci (const deci a, const deci b, uint32_t *st) {
+    deci c;
+    uint64_t sa[] = {M_LO(a), M_HI(a)}, sb[] = {M_LO(b), M_HI(b)}, sc[5];
     int32_t shift, tc = 0, e, f = 0;
 
     /* compute the sign */
     c.s = (!a.s && b.s) || (a.s && !b.s);
 
+    /*
+        small-value tier: a product of 64-bit significands below 1e26 needs
+        no normalization, and with the exponent in range no m_ldexp either
+    */
+    if ((a.m2 == 0) && (b.m2 == 0)) {
+        uint128_t p = (uint128_t) sa[0] * sb[0];
+        e = a.e + b.e;
+        if ((p <= ((uint128_t) P26_1[1] << 64 | P26_1[0])) && (e >= -128) && (e <= 127)) {
+            sc[0] = MASK64(p);
+            sc[1] = (uint64_t)(p >> 64);
+            m_to_deci (&c, sc);
+            c.e = (p == 0) ? 0 : e;
+            return c;
+        }
+    }
+
     /* multiply sa by sb yielding "double significand" sc */
-    m_multiply (sc, 3, sa, 3, sb);
+    m_multiply (sc, 2, sa, 2, sb);
 
     /* normalize "double significand" sc and round if needed */
     shift = min_shift_right (sc);
     e = a.e + b.e + shift;
     if (shift > 0) {
-        dsr (6, sc, shift, &tc);
+        dsr (4, sc, shift, &tc);
         if (((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) && (e >= -128)) m_add_1 (sc, 1);
     }
 
-    m_ldexp (sc, &f, e, tc);
-    c.m0 = sc[0];
-    c.m1 = sc[1];
-    c.m2 = sc[2];
+    m_ldexp (sc, &f, e, tc, st);
+    m_to_deci (&c, sc);
     c.e = f;
     return c;
 }
 
+#endif
+
+deci deci_multiply (const deci a, const deci b) {
+    return multiply_deci (a, b, NULL);
+}
+
+#define MAX_FMA 8
+
+/* Counts the decimal digits of nonzero significand a with length n */
+INLINE int32_t m_digits_n (int32_t n, const uint64_t a[]) {
+    uint64_t b[MAX_FMA];
+    int32_t d = 0, i;
+
+    for (; (n > 1) && (a[n - 1] == 0); n--) NOOP;
+    memcpy (b, a, n * sizeof (uint64_t));
+    for (; n > 1; d += MAX_LIMB_DIGITS) {
+        m_divide_pow10 (n, b, b, MAX_LIMB_DIGITS);
+        if (b[n - 1] == 0) n--;
+    }
+    for (i = 1; (i <= MAX_LIMB_DIGITS) && (b[0] >= P[i][0]); i++) NOOP;
+    return d + i;
+}
+
+/* Multiplies significand a with length n by 10 ** k; returns the new length */
+INLINE int32_t m_scale_pow10 (int32_t n, uint64_t a[], int32_t k) {
+    int32_t k1;
+    for (; k > 0; k -= k1) {
+        k1 = MAX_LIMB_DIGITS <= k ? MAX_LIMB_DIGITS : k;
+        m_multiply_1 (n, a, a, P[k1][0]);
+        if (a[n] != 0) n++;
+    }
+    return n;
+}
+
+/*
+    Computes a * b + c rounding only once;
+    the product is kept exactly in 4 limbs; when c lies completely below
+    the rounding position of the product, or the product below that of c,
+    the smaller one is replaced by one unit below all digits of the larger,
+    which rounds the same way and keeps the exact sum within 8 limbs;
+*/
+INLINE deci fma_deci (deci a, deci b, deci c, uint32_t *st) {
+    deci r;
+    uint64_t sa[] = {M_LO(a), M_HI(a)}, sb[] = {M_LO(b), M_HI(b)};
+    uint64_t x[MAX_FMA] = {0}, y[MAX_FMA] = {0}, s[MAX_FMA];
+    uint64_t *big = x, *small = y;
+    int32_t ex = a.e + b.e, ey = c.e, eb, es, tb = 0, f = 0;
+    int32_t nb, ns, topb, tops, k, e, d, cut;
+    bool sx = (a.s != b.s), sb_, ss, tiny = false;
+
+    /* small-value tier: exact 128-bit sums below 1e26 */
+    if ((a.m2 == 0) && (b.m2 == 0) && (c.m2 == 0)) {
+        uint128_t p = (uint128_t) sa[0] * sb[0], q = M_LO(c), t;
+        bool fits = true;
+        e = ex;
+        if (ex > ey) {
+            /* p * 10 ** 19 fits when p does in 64 bits */
+            fits = (ex - ey <= MAX_LIMB_DIGITS) && ((p >> 64) == 0);
+            if (fits) p *= P[ex - ey][0];
+            e = ey;
+        } else if (ey > ex) {
+            fits = (ey - ex <= MAX_LIMB_DIGITS);
+            if (fits) q *= P[ey - ex][0];
+        }
+        r.s = sx;
+        if (sx == c.s) {
+            t = p + q;
+            fits = fits && (t >= p);
+        } else if (p >= q) t = p - q;
+        else {
+            t = q - p;
+            r.s = c.s;
+        }
+        if (fits && (t <= ((uint128_t) P26_1[1] << 64 | P26_1[0])) && (e >= -128) && (e <= 127)) {
+            s[0] = MASK64(t);
+            s[1] = (uint64_t)(t >> 64);
+            m_to_deci (&r, s);
+            r.e = (t == 0) ? 0 : e;
+            return r;
+        }
+    }
+
+    /* the exact product */
+    m_multiply (x, 2, sa, 2, sb);
+    if (m_is_zero (4, x)) return c;
+    if (deci_is_zero (c)) {
+        ey = ex;  /* y is zero, not used for the rounding position */
+        tops = INT32_MIN;
+    } else {
+        y[0] = sa[0] = M_LO(c);
+        y[1] = sa[1] = M_HI(c);
+        tops = ey + m_digits_n (2, sa);
+    }
+    topb = ex + m_digits_n (4, x);
+
+    /* big is the one with the highest digit */
+    eb = ex;
+    sb_ = sx;
+    es = ey;
+    ss = c.s;
+    if (tops > topb) {
+        big = y;
+        small = x;
+        eb = ey;
+        sb_ = c.s;
+        es = ex;
+        ss = sx;
+        k = topb;
+        topb = tops;
+        tops = k;
+    }
+
+    /* a small addend below the rounding position becomes one unit */
+    k = (eb < topb - 29 ? eb : topb - 29) - 1;
+    if ((tops != INT32_MIN) && (tops <= k)) {
+        memset (small, 0, MAX_FMA * sizeof (uint64_t));
+        small[0] = 1;
+        es = k;
+    }
+
+    /* align to the lower exponent and add */
+    e = eb < es ? eb : es;
+    nb = m_scale_pow10 (4, big, eb - e);
+    ns = m_scale_pow10 (4, small, es - e);
+    assert((nb < MAX_FMA) && (ns < MAX_FMA));
+    if (sb_ == ss) {
+        m_add (MAX_FMA - 1, s, big, small);
+        r.s = sb_;
+    } else if (m_subtract (MAX_FMA, s, big, small)) {
+        m_negate (MAX_FMA, s);
+        r.s = ss;
+    } else r.s = sb_;
+    if (m_is_zero (MAX_FMA, s)) return deci_zero;
+
+    /* round once to 26 digits, or to the exponent -128 */
+    d = m_digits_n (MAX_FMA, s);
+    cut = d > 26 ? d - 26 : 0;
+    if (e + cut < -128) {
+        cut = -128 - e;
+        tiny = true;
+    }
+    dsr (MAX_FMA, s, cut, &tb);
+    if (st && tb) *st |= tiny ? DECI_INEXACT | DECI_UNDERFLOW : DECI_INEXACT;
+    if ((tb == 3) || ((tb == 2) && (s[0] % 2 == 1))) {
+        m_add_1 (s, 1);
+        if (m_cmp (2, s, P26) == 0) {
+            s[0] = P[25][0];
+            s[1] = P[25][1];
+            cut++;
+        }
+    }
+
+    m_ldexp (s, &f, e + cut, 0, st);
+    m_to_deci (&r, s);
+    r.e = f;
+    return r;
+}
+
+deci deci_fma (deci a, deci b, deci c) {
+    return fma_deci (a, b, c, NULL);
+}
+
 /*
     b[m - 1] is supposed to be nonzero;
     m <= n required;
     a, b are copied on entry;
-    uses 64-bit arithmetic;
+    uses 128-bit arithmetic;
 */
 
-#define MAX_N 7
-#define MAX_M 3
+#define MAX_N 4
+#define MAX_M 2
 
 INLINE void m_divide (
-    uint32_t q[/* n - m + 1 */],
-    uint32_t r[/* m */],
+    uint64_t q[/* n - m + 1 */],
+    uint64_t r[/* m */],
     const int32_t n,
-    const uint32_t a[/* n */],
+    const uint64_t a[/* n */],
     const int32_t m,
-    const uint32_t b[/* m */]
+    const uint64_t b[/* m */]
 ){
-    uint32_t c[MAX_N + 1], d[MAX_M + 1], e[MAX_M + 1];
-    uint32_t bm = b[m - 1];
-    uint64_t cm, dm;
-    int32_t i, j, k;
+    uint64_t c[MAX_N + 1], d[MAX_M], e[MAX_M + 1];
+    uint64_t qm, rm;
+    bool fits;
+    int32_t i, j;
 
     if (m <= 1) {  // array out of bounds patch, see [F]
         assert(m != 0);  // also, [F]
-        r[0] = m_divide_1 (n, q, a, bm);
+        r[0] = m_divide_1 (n, q, a, b[0]);
         return;
     }
 
     /*
         we shift both the divisor and the dividend to the left
-        to obtain quotients that are off by one at most
+        so that the most significant bit of b[m - 1] is set;
+        the quotient estimates are then off by one at most
+        after the usual test against the second divisor limb
     */
-    /* the most significant bit of b[m - 1] */
-    i = 0;
-    j = 31;
-    while (i < j) {
-        k = (i + j + 1) / 2;
-        if ((uint32_t)(1 << k) <= bm) i = k; else j = k - 1;
-    }
+    i = __builtin_clzll (b[m - 1]);
 
     /* shift the dividend to the left */
-    for (j = 0; j < n; j++) c[j] = a[j] << (31 - i);
-    c[n] = 0;
-    for (j = 0; j < n; j++) c[j + 1] |= a[j] >> (i + 1);
+    c[n] = i ? a[n - 1] >> (64 - i) : 0;
+    for (j = n - 1; j > 0; j--)
+        c[j] = a[j] << i | (i ? a[j - 1] >> (64 - i) : 0);
+    c[0] = a[0] << i;
 
     /* shift the divisor to the left */
-    for (j = 0; j < m; j++) d[j] = b[j] << (31 - i);
-    d[m] = 0;
-    for (j = 0; j < m; j++) d[j + 1] |= b[j] >> (i + 1);
-
-    dm = (uint64_t) d[m - 1];
+    for (j = m - 1; j > 0; j--)
+        d[j] = b[j] << i | (i ? b[j - 1] >> (64 - i) : 0);
+    d[0] = b[0] << i;
 
     for (j = n - m; j >= 0; j--) {
-        cm = ((uint64_t) c[j + m] << 32) + (uint64_t) c[j + m - 1];
-        cm /= dm;
-        if (cm > 0xffffffffu) cm = 0xffffffffu;
-        m_multiply_1 (m, e, d, (uint32_t) cm);
+        if (c[j + m] >= d[m - 1]) {
+            qm = UINT64_MAX;
+            rm = c[j + m - 1] + d[m - 1];
+            fits = rm >= d[m - 1];
+        } else {
+            qm = div_128 (c[j + m], c[j + m - 1], d[m - 1], &rm);
+            fits = true;
+        }
+        while (fits && (uint128_t) qm * d[m - 2] > ((uint128_t) rm << 64 | c[j + m - 2])) {
+            qm--;
+            rm += d[m - 1];
+            fits = rm >= d[m - 1];
+        }
+        m_multiply_1 (m, e, d, qm);
         if (m_subtract (m + 1, c + j, c + j, e)) {
             /* the quotient is off by one */
-            cm--;
+            qm--;
             m_add (m, c + j, c + j, d);
         }
-        q[j] = (uint32_t) cm;
+        q[j] = qm;
+    }
+
+    /* shift the remainder back to the right */
+    c[m] = 0;
+    for (j = 0; j < m; j++)
+        r[j] = c[j] >> i | (i ? c[j + 1] << (64 - i) : 0);
+}
+
+/*
+    Computes the decimal shift of the nonzero significand of a needed to
+    obtain the highest accuracy when dividing it by a significand whose
+    decimal logarithm is l10b;
+    using double arithmetic;
+*/
+INLINE int32_t divide_shift (const deci a, double l10b) {
+    double a_dbl = (a.m2 * two_to_32 + a.m1) * two_to_32 + a.m0;
+    return (int32_t)ceil (25.5 + l10b - log10 (a_dbl));
+}
+
+/*
+    Normalizes and rounds the quotient q of a significand division with
+    remainder r by significand b of length nb, yielding c with exponent e;
+*/
+INLINE deci divide_round (deci c, int32_t e, uint64_t q[4], uint64_t r[3], int32_t nb, const uint64_t b[3], uint32_t *st) {
+    int32_t shift, tc, f = 0;
+
+    /* compute the truncate flag */
+    m_multiply_1 (nb, r, r, 2);
+    tc = m_cmp (nb + 1, r, b);
+    if (tc >= 0) tc = tc == 0 ? 2 : 3;
+    else tc = m_is_zero (nb + 1, r) ? 0 : 1;
+
+    /* normalize the significand q */
+    shift = min_shift_right (q);
+    if (shift > 0) {
+        dsr (3, q, shift, &tc);
+        e += shift;
+    }
+
+    /* round q if needed */
+    if (((tc == 3) || ((tc == 2) && (q[0] % 2 == 1))) && (e >= -128)) m_add_1 (q, 1);
+
+    m_ldexp (q, &f, e, tc, st);
+    m_to_deci (&c, q);
+    c.e = f;
+    return c;
+}
+
+#ifdef DECI_DECIMAL128
+
+/*
+    Divides significands ca by nonzero cb with _Decimal128 arithmetic,
+    for the quotient exponent e, the sign s;
+    the quotient is truncated by the sign of its residual like a product,
+    and an exact one gets 26 digits, as the shifted dividend of deci_divide
+    gives them;
+*/
+INLINE deci d128_divide (bool s, uint128_t ca, uint128_t cb, int32_t e, uint32_t *st) {
+    bool sq;
+    uint128_t t, r;
+    int32_t k, d, tc = 0;
+
+    t = d128_to_parts (d128_from_parts (false, ca, 0) / d128_from_parts (false, cb, 0), &sq, &k);
+    if (k < 0) {
+        r = ca * pow10_128 (-k) - t * cb;
+        if (r >> 127) t--;
+        tc = r != 0;
+    }
+    if (!tc && ((d = digits_128 (t)) < 26)) {
+        t *= pow10_128 (26 - d);
+        k -= 26 - d;
+    }
+
+    return d128_round (s, t, tc, e + k, st);
+}
+
+ALWAYS_INLINE deci divide_deci (deci a, deci b, uint32_t *st) {
+    deci c;
+
+    if (deci_is_zero (b)) {
+        raise_status (st, DECI_DIVIDE_BY_ZERO);
+        return deci_zero;
+    }
+
+    /* compute sign */
+    c.s = (!a.s && b.s) || (a.s && !b.s);
+
+    if (deci_is_zero (a)) {
+        c.m0 = 0;
+        c.m1 = 0;
+        c.m2 = 0;
+        c.e = 0;
+        return c;
+    }
+
+    return d128_divide (
+        c.s,
+        (uint128_t) M_HI(a) << 64 | M_LO(a),
+        (uint128_t) M_HI(b) << 64 | M_LO(b),
+        a.e - b.e,
+        st
+    );
+}
+
+#else
+
+/* uses double arithmetic */
+ALWAYS_INLINE deci divide_deci (deci a, deci b, uint32_t *st) {
+    int32_t e = a.e - b.e;
+    deci c;
+    uint64_t q[] = {0, 0, 0, 0}, r[3];
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0, 0}, sb[] = {M_LO(b), M_HI(b), 0};
+    int32_t shift, na, nb;
+
+    if (deci_is_zero (b)) {
+        raise_status (st, DECI_DIVIDE_BY_ZERO);
+        return deci_zero;
+    }
+
+    /* compute sign */
+    c.s = (!a.s && b.s) || (a.s && !b.s);
+
+    if (deci_is_zero (a)) {
+        c.m0 = 0;
+        c.m1 = 0;
+        c.m2 = 0;
+        c.e = 0;
+        return c;
+    }
+
+    /* compute decimal shift needed to obtain the highest accuracy */
+    shift = divide_shift (a, log10 ((b.m2 * two_to_32 + b.m1) * two_to_32 + b.m0));
+    dsl (2, sa, shift);
+    e -= shift;
+
+    /* count radix 2 ** 64 digits of the shifted significand sa */
+    for (na = 3; sa[na - 1] == 0; na--) NOOP;
+
+    nb = sb[1] ? 2 : 1;
+    m_divide (q, r, na, sa, nb, sb);
+
+    return divide_round (c, e, q, r, nb, sb, st);
+}
+
+#endif
+
+deci deci_divide (deci a, deci b) {
+    return divide_deci (a, b, NULL);
+}
+
+/*
+    Divides u2:u1:u0 by the normalized significand d1:d0 with reciprocal v,
+    u2:u1 < d1:d0 required;
+    returns the quotient and stores the remainder to r1:r0;
+    same source as above;
+*/
+INLINE uint64_t div_3by2 (
+    uint64_t u2, uint64_t u1, uint64_t u0,
+    uint64_t d1, uint64_t d0, uint64_t v,
+    uint64_t *r1, uint64_t *r0
+){
+    uint128_t d = (uint128_t) d1 << 64 | d0, rr;
+    uint128_t p = (uint128_t) v * u2 + ((uint128_t) u2 << 64 | u1);
+    uint64_t q1 = (uint64_t)(p >> 64), q0 = MASK64(p);
+
+    rr = ((uint128_t)(u1 - q1 * d1) << 64 | u0) - d - (uint128_t) d0 * q1;
+    q1++;
+    if ((uint64_t)(rr >> 64) >= q0) {
+        q1--;
+        rr += d;
+    }
+    if (rr >= d) {
+        q1++;
+        rr -= d;
+    }
+    *r1 = (uint64_t)(rr >> 64);
+    *r0 = MASK64(rr);
+    return q1;
+}
+
+/*
+    Normalizes the significand p->b of length p->n to have the highest bit
+    set and computes its reciprocal;
+*/
+INLINE void prepare_reciprocal (deci_divisor *p) {
+    static const uint64_t ones[] = {UINT64_MAX, UINT64_MAX, UINT64_MAX};
+    uint64_t q[2], r[2];
+    int32_t i;
+
+    p->shift = i = __builtin_clzll (p->b[p->n - 1]);
+    if (p->n == 1) {
+        p->d[0] = p->b[0] << i;
+        p->d[1] = 0;
+        /* floor ((2 ** 128 - 1) / d) - 2 ** 64 */
+        p->v = MASK64(~(uint128_t) 0 / p->d[0]);
+    } else {
+        p->d[1] = p->b[1] << i | (i ? p->b[0] >> (64 - i) : 0);
+        p->d[0] = p->b[0] << i;
+        /* floor ((2 ** 192 - 1) / d) - 2 ** 64, q[1] is 1 */
+        m_divide (q, r, 3, ones, 2, p->d);
+        p->v = q[0];
+    }
+}
+
+/*
+    Prepares nonzero deci b for repeated division by it;
+    the significand is normalized to have the highest bit set and its
+    reciprocal is computed, so deci_divide_prepared needs no division
+    instruction, and log10 of the significand is cached;
+*/
+void deci_prepare_divisor (deci_divisor *p, deci b) {
+    if (deci_is_zero (b)) DIVIDE_BY_ZERO_ERROR;
+
+    p->b[0] = M_LO(b);
+    p->b[1] = M_HI(b);
+    p->b[2] = 0;
+    p->n = p->b[1] ? 2 : 1;
+    p->s = b.s;
+    p->e = b.e;
+    p->l10 = log10 ((b.m2 * two_to_32 + b.m1) * two_to_32 + b.m0);
+
+    prepare_reciprocal (p);
+}
+
+/*
+    Divides significand a by prepared divisor p yielding quotient q
+    and remainder r, like m_divide;
+*/
+INLINE void m_divide_prepared (uint64_t q[], uint64_t r[], const int32_t n, const uint64_t a[], const deci_divisor *p) {
+    uint64_t c[MAX_N + 1], r1, r0;
+    int32_t i = p->shift, j;
+
+    /* shift the dividend to the left like the divisor */
+    c[n] = i ? a[n - 1] >> (64 - i) : 0;
+    for (j = n - 1; j > 0; j--)
+        c[j] = a[j] << i | (i ? a[j - 1] >> (64 - i) : 0);
+    c[0] = a[0] << i;
+
+    if (p->n == 1) {
+        r0 = c[n];
+        for (j = n - 1; j >= 0; j--)
+            q[j] = div_2by1 (r0, c[j], p->d[0], p->v, &r0);
+        r[0] = r0 >> i;
+        return;
+    }
+
+    r1 = c[n];
+    r0 = c[n - 1];
+    for (j = n - 2; j >= 0; j--)
+        q[j] = div_3by2 (r1, r0, c[j], p->d[1], p->d[0], p->v, &r1, &r0);
+    r[0] = r0 >> i | (i ? r1 << (64 - i) : 0);
+    r[1] = r1 >> i;
+}
+
+#ifdef DECI_DECIMAL128
+
+/* the prepared divisor only saves the check for zero here */
+ALWAYS_INLINE deci divide_deci_prepared (deci a, const deci_divisor *p, uint32_t *st) {
+    deci c;
+
+    /* compute sign */
+    c.s = (!a.s && p->s) || (a.s && !p->s);
+
+    if (deci_is_zero (a)) {
+        c.m0 = 0;
+        c.m1 = 0;
+        c.m2 = 0;
+        c.e = 0;
+        return c;
+    }
+
+    return d128_divide (
+        c.s,
+        (uint128_t) M_HI(a) << 64 | M_LO(a),
+        (uint128_t) p->b[1] << 64 | p->b[0],
+        a.e - p->e,
+        st
+    );
+}
+
+#else
+
+/* deci_divide by a divisor prepared with deci_prepare_divisor */
+ALWAYS_INLINE deci divide_deci_prepared (deci a, const deci_divisor *p, uint32_t *st) {
+    int32_t e = a.e - p->e;
+    deci c;
+    uint64_t q[] = {0, 0, 0, 0}, r[3];
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0, 0};
+    int32_t shift, na;
+
+    /* compute sign */
+    c.s = (!a.s && p->s) || (a.s && !p->s);
+
+    if (deci_is_zero (a)) {
+        c.m0 = 0;
+        c.m1 = 0;
+        c.m2 = 0;
+        c.e = 0;
+        return c;
+    }
+
+    /* compute decimal shift needed to obtain the highest accuracy */
+    shift = divide_shift (a, p->l10);
+    dsl (2, sa, shift);
+    e -= shift;
+
+    /* count radix 2 ** 64 digits of the shifted significand sa */
+    for (na = 3; sa[na - 1] == 0; na--) NOOP;
+
+    m_divide_prepared (q, r, na, sa, p);
+
+    return divide_round (c, e, q, r, p->n, p->b, st);
+}
+
+#endif
+
+deci deci_divide_prepared (deci a, const deci_divisor *p) {
+    return divide_deci_prepared (a, p, NULL);
+}
+
+/*
+    deci_multiply by an integer, the same as deci_multiply (a, int_to_deci (b));
+    the product of the significand and |b| has three limbs at most, so it
+    takes one m_multiply_1 instead of the two by two limb product;
+*/
+deci deci_multiply_int (deci a, int64_t b) {
+    deci c;
+    uint64_t sa[] = {M_LO(a), M_HI(a)}, sc[] = {0, 0, 0, 0};
+    uint64_t ub = b < 0 ? -(uint64_t) b : (uint64_t) b;
+    int32_t shift, tc = 0, e = a.e, f = 0;
+
+    c.s = a.s != (b < 0);
+
+    m_multiply_1 (2, sc, sa, ub);
+
+    /* normalize and round like a product */
+    shift = min_shift_right (sc);
+    e += shift;
+    if (shift > 0) {
+        dsr (3, sc, shift, &tc);
+        if (((tc == 3) || ((tc == 2) && (sc[0] % 2 == 1))) && (e >= -128)) m_add_1 (sc, 1);
+    }
+
+    m_ldexp (sc, &f, e, tc, NULL);
+    m_to_deci (&c, sc);
+    c.e = f;
+    return c;
+}
+
+/*
+    deci_divide by an integer, the same as deci_divide (a, int_to_deci (b));
+    |b| fits one limb, so the digit count of the shifted dividend is exact
+    without the double logarithms and the division is one m_divide_1;
+*/
+deci deci_divide_int (deci a, int64_t b) {
+    deci c;
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0, 0}, q[] = {0, 0, 0, 0}, r[] = {0, 0, 0};
+    uint64_t sb[] = {b < 0 ? -(uint64_t) b : (uint64_t) b, 0, 0};
+    int32_t shift, na;
+
+    if (b == 0) DIVIDE_BY_ZERO_ERROR;
+
+    c.s = a.s != (b < 0);
+
+    if (m_is_zero (2, sa)) {
+        c.m0 = 0;
+        c.m1 = 0;
+        c.m2 = 0;
+        c.e = 0;
+        return c;
+    }
+
+    /* a quotient of 26 or 27 digits, the dividend stays below 1e45 */
+    shift = 26 - m_digits (sa) + m_digits (sb);
+    dsl (2, sa, shift);
+
+    for (na = 3; sa[na - 1] == 0; na--) NOOP;
+    r[0] = m_divide_1 (na, q, sa, sb[0]);
+
+    return divide_round (c, a.e - shift, q, r, 1, sb, NULL);
+}
+
+/*
+    Array operations, c[i] = a[i] op b[i] for 0 <= i < n;
+    c may be the same as a or b;
+    the loops use the inlined scalar operations, so the arguments are not
+    passed per element and the invariant unpacking of a scalar b is hoisted;
+    an error leaves the elements before the failing one computed;
+*/
+
+void deci_add_n (deci c[], const deci a[], const deci b[], size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], b[i], NULL);
+}
+
+void deci_subtract_n (deci c[], const deci a[], const deci b[], size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], deci_negate (b[i]), NULL);
+}
+
+void deci_multiply_n (deci c[], const deci a[], const deci b[], size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = multiply_deci (a[i], b[i], NULL);
+}
+
+void deci_divide_n (deci c[], const deci a[], const deci b[], size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = divide_deci (a[i], b[i], NULL);
+}
+
+/* Array operations with a scalar, c[i] = a[i] op b for 0 <= i < n */
+
+void deci_add_scalar_n (deci c[], const deci a[], deci b, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], b, NULL);
+}
+
+void deci_subtract_scalar_n (deci c[], const deci a[], deci b, size_t n) {
+    deci_add_scalar_n (c, a, deci_negate (b), n);
+}
+
+void deci_multiply_scalar_n (deci c[], const deci a[], deci b, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = multiply_deci (a[i], b, NULL);
+}
+
+/* the divisor is prepared once, see deci_prepare_divisor */
+void deci_divide_scalar_n (deci c[], const deci a[], deci b, size_t n) {
+    deci_divisor p;
+    size_t i;
+    if (n == 0) return;
+    deci_prepare_divisor (&p, b);
+    for (i = 0; i < n; i++) c[i] = divide_deci_prepared (a[i], &p, NULL);
+}
+
+/*
+    Checked operations: instead of panicking, they return the status flags
+    DECI_OVERFLOW, DECI_DIVIDE_BY_ZERO, DECI_INEXACT and DECI_UNDERFLOW of
+    deci.h; a result that overflows or divides by zero is zero;
+*/
+
+uint32_t deci_add_checked (deci *c, deci a, deci b) {
+    uint32_t st = 0;
+    *c = add_deci (a, b, &st);
+    return st;
+}
+
+uint32_t deci_subtract_checked (deci *c, deci a, deci b) {
+    uint32_t st = 0;
+    *c = add_deci (a, deci_negate (b), &st);
+    return st;
+}
+
+uint32_t deci_multiply_checked (deci *c, deci a, deci b) {
+    uint32_t st = 0;
+    *c = multiply_deci (a, b, &st);
+    return st;
+}
+
+uint32_t deci_divide_checked (deci *c, deci a, deci b) {
+    uint32_t st = 0;
+    *c = divide_deci (a, b, &st);
+    return st;
+}
+
+uint32_t deci_fma_checked (deci *r, deci a, deci b, deci c) {
+    uint32_t st = 0;
+    *r = fma_deci (a, b, c, &st);
+    return st;
+}
+
+/* checked array operations, the flags of all the elements are combined */
+
+uint32_t deci_add_n_checked (deci c[], const deci a[], const deci b[], size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], b[i], &st);
+    return st;
+}
+
+uint32_t deci_subtract_n_checked (deci c[], const deci a[], const deci b[], size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], deci_negate (b[i]), &st);
+    return st;
+}
+
+uint32_t deci_multiply_n_checked (deci c[], const deci a[], const deci b[], size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = multiply_deci (a[i], b[i], &st);
+    return st;
+}
+
+uint32_t deci_divide_n_checked (deci c[], const deci a[], const deci b[], size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = divide_deci (a[i], b[i], &st);
+    return st;
+}
+
+uint32_t deci_add_scalar_n_checked (deci c[], const deci a[], deci b, size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = add_deci (a[i], b, &st);
+    return st;
+}
+
+uint32_t deci_subtract_scalar_n_checked (deci c[], const deci a[], deci b, size_t n) {
+    return deci_add_scalar_n_checked (c, a, deci_negate (b), n);
+}
+
+uint32_t deci_multiply_scalar_n_checked (deci c[], const deci a[], deci b, size_t n) {
+    uint32_t st = 0;
+    size_t i;
+    for (i = 0; i < n; i++) c[i] = multiply_deci (a[i], b, &st);
+    return st;
+}
+
+uint32_t deci_divide_scalar_n_checked (deci c[], const deci a[], deci b, size_t n) {
+    deci_divisor p;
+    uint32_t st = 0;
+    size_t i;
+    if (n == 0) return 0;
+    if (deci_is_zero (b)) {
+        for (i = 0; i < n; i++) c[i] = deci_zero;
+        return DECI_DIVIDE_BY_ZERO;
+    }
+    deci_prepare_divisor (&p, b);
+    for (i = 0; i < n; i++) c[i] = divide_deci_prepared (a[i], &p, &st);
+    return st;
+}
+
+/*
+    Packed columns: the parts of n decis stored separately, 14 bytes per
+    value: the low 64 bits of the significands, their high 23 bits, the
+    exponents and the signs; each column starts at a multiple of 64 bytes
+    from the base, so the columns are cache-aligned if the base is;
+*/
+
+INLINE size_t column_bytes (size_t size) {
+    return (size + 63) & ~(size_t) 63;
+}
+
+/* bytes needed for columns of capacity cap */
+size_t deci_columns_size (size_t cap) {
+    return column_bytes (8 * cap) + column_bytes (4 * cap) + 2 * column_bytes (cap);
+}
+
+/* lays out columns of capacity cap at base, which is 8-byte aligned at least */
+void deci_columns_at (deci_columns *v, Byte *base, size_t cap) {
+    v->lo = (uint64_t *) base;
+    base += column_bytes (8 * cap);
+    v->hi = (uint32_t *) base;
+    base += column_bytes (4 * cap);
+    v->e = (int8_t *) base;
+    base += column_bytes (cap);
+    v->s = base;
+}
+
+/*
+    Moves the first n values of the columns of capacity from_cap at base to
+    the layout of capacity to_cap >= from_cap, as when the space has grown;
+    the columns move up, so the last one is moved first;
+*/
+void deci_columns_move (Byte *base, size_t from_cap, size_t to_cap, size_t n) {
+    deci_columns a, b;
+
+    deci_columns_at (&a, base, from_cap);
+    deci_columns_at (&b, base, to_cap);
+    memmove (b.s, a.s, n);
+    memmove (b.e, a.e, n);
+    memmove (b.hi, a.hi, 4 * n);
+}
+
+INLINE deci column_get (const deci_columns *v, size_t i) {
+    deci a;
+    a.m0 = (uint32_t) v->lo[i];
+    a.m1 = (uint32_t)(v->lo[i] >> 32);
+    a.m2 = v->hi[i];
+    a.s = v->s[i];
+    a.e = v->e[i];
+    return a;
+}
+
+INLINE void column_put (const deci_columns *v, size_t i, deci a) {
+    v->lo[i] = M_LO(a);
+    v->hi[i] = a.m2;
+    v->s[i] = a.s;
+    v->e[i] = a.e;
+}
+
+deci deci_columns_get (const deci_columns *v, size_t i) {
+    return column_get (v, i);
+}
+
+void deci_columns_put (const deci_columns *v, size_t i, deci a) {
+    column_put (v, i, a);
+}
+
+/* a[j] = value i + j of the columns, for 0 <= j < n */
+void deci_columns_get_n (deci a[], const deci_columns *v, size_t i, size_t n) {
+    size_t j;
+    for (j = 0; j < n; j++) a[j] = deci_columns_get (v, i + j);
+}
+
+/* value i + j of the columns = a[j], for 0 <= j < n */
+void deci_columns_put_n (const deci_columns *v, size_t i, const deci a[], size_t n) {
+    size_t j;
+    for (j = 0; j < n; j++) deci_columns_put (v, i + j, a[j]);
+}
+
+/*
+    Column arithmetic, see [H]; the scalar loops handle the values i to n - 1
+    and are also used by the vector loops for the blocks they cannot take;
+*/
+
+INLINE uint32_t add_columns (const deci_columns *c, const deci_columns *a, const deci_columns *b, bool sub, size_t i, size_t n) {
+    uint32_t st = 0;
+    deci y;
+    for (; i < n; i++) {
+        y = column_get (b, i);
+        if (sub) y.s = !y.s;
+        column_put (c, i, add_deci (column_get (a, i), y, &st));
+    }
+    return st;
+}
+
+INLINE void compare_columns (int8_t r[], const deci_columns *a, const deci_columns *b, size_t i, size_t n) {
+    for (; i < n; i++) r[i] = (int8_t) deci_compare (column_get (a, i), column_get (b, i));
+}
+
+INLINE uint32_t ldexp_columns (const deci_columns *c, const deci_columns *a, int32_t k, size_t i, size_t n) {
+    uint32_t st = 0;
+    for (; i < n; i++) column_put (c, i, ldexp_deci (column_get (a, i), k, &st));
+    return st;
+}
+
+#ifdef DECI_SIMD
+
+/* moves bit j of m to the low bit of byte j */
+#define BITS_TO_BYTES_4(m) (((uint32_t)(m) * 0x00204081u) & 0x01010101u)
+#define BITS_TO_BYTES_8(m) \
+    (BITS_TO_BYTES_4 ((m) & 15u) | (uint64_t) BITS_TO_BYTES_4 ((m) >> 4 & 15u) << 32)
+
+/* 0 or 1 in each byte to 0 or -1 in each 64-bit lane */
+__attribute__((target("avx2")))
+INLINE __m256i lanes_from_bytes_avx2 (uint32_t x) {
+    return _mm256_sub_epi64 (_mm256_setzero_si256 (), _mm256_cvtepu8_epi64 (_mm_cvtsi32_si128 ((int) x)));
+}
+
+/* unsigned a < b in each 64-bit lane */
+__attribute__((target("avx2")))
+INLINE __m256i less_epu64_avx2 (__m256i a, __m256i b) {
+    const __m256i bias = _mm256_set1_epi64x (INT64_MIN);
+    return _mm256_cmpgt_epi64 (_mm256_xor_si256 (b, bias), _mm256_xor_si256 (a, bias));
+}
+
+/*
+    4 values per step; a block is done in the vector unit when the exponents
+    are equal, the high parts zero and no 64-bit sum overflows, which
+    is add_small() of add_deci(): same signs add, different ones subtract
+    the smaller magnitude from the bigger one, taking its sign;
+*/
+__attribute__((target("avx2")))
+static uint32_t add_columns_avx2 (const deci_columns *c, const deci_columns *a, const deci_columns *b, bool sub, size_t n) {
+    uint32_t st = 0, ea, eb, sa, sb, sel;
+    __m256i la, lb, sum, diff, same, lt;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        memcpy (&ea, a->e + i, 4);
+        memcpy (&eb, b->e + i, 4);
+        __m128i h = _mm_or_si128 (
+            _mm_loadu_si128 ((const __m128i *)(a->hi + i)),
+            _mm_loadu_si128 ((const __m128i *)(b->hi + i))
+        );
+        if ((ea != eb) || !_mm_testz_si128 (h, h)) {
+            st |= add_columns (c, a, b, sub, i, i + 4);
+            continue;
+        }
+        memcpy (&sa, a->s + i, 4);
+        memcpy (&sb, b->s + i, 4);
+        if (sub) sb ^= 0x01010101u;
+        la = _mm256_loadu_si256 ((const __m256i *)(a->lo + i));
+        lb = _mm256_loadu_si256 ((const __m256i *)(b->lo + i));
+        sum = _mm256_add_epi64 (la, lb);
+        same = _mm256_cmpeq_epi64 (lanes_from_bytes_avx2 (sa), lanes_from_bytes_avx2 (sb));
+        if (_mm256_movemask_pd (_mm256_castsi256_pd (_mm256_and_si256 (same, less_epu64_avx2 (sum, la))))) {
+            st |= add_columns (c, a, b, sub, i, i + 4);
+            continue;
+        }
+        lt = less_epu64_avx2 (la, lb);
+        diff = _mm256_blendv_epi8 (_mm256_sub_epi64 (la, lb), _mm256_sub_epi64 (lb, la), lt);
+        sel = BITS_TO_BYTES_4 (_mm256_movemask_pd (_mm256_castsi256_pd (_mm256_andnot_si256 (same, lt)))) * 0xFFu;
+        sa = (sa & ~sel) | (sb & sel);
+        _mm256_storeu_si256 ((__m256i *)(c->lo + i), _mm256_blendv_epi8 (diff, sum, same));
+        _mm_storeu_si128 ((__m128i *)(c->hi + i), _mm_setzero_si128 ());
+        memcpy (c->e + i, &ea, 4);
+        memcpy (c->s + i, &sa, 4);
+    }
+    return st | add_columns (c, a, b, sub, i, n);
+}
+
+/* 4 values per step; signed 64-bit compare for equal exponents and magnitudes below 2 ** 63 */
+__attribute__((target("avx2")))
+static void compare_columns_avx2 (int8_t r[], const deci_columns *a, const deci_columns *b, size_t n) {
+    uint32_t ea, eb, sa, sb, gt, lt;
+    __m256i la, lb, na, nb;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        memcpy (&ea, a->e + i, 4);
+        memcpy (&eb, b->e + i, 4);
+        __m128i h = _mm_or_si128 (
+            _mm_loadu_si128 ((const __m128i *)(a->hi + i)),
+            _mm_loadu_si128 ((const __m128i *)(b->hi + i))
+        );
+        la = _mm256_loadu_si256 ((const __m256i *)(a->lo + i));
+        lb = _mm256_loadu_si256 ((const __m256i *)(b->lo + i));
+        if (
+            (ea != eb) || !_mm_testz_si128 (h, h)
+            || _mm256_movemask_pd (_mm256_castsi256_pd (_mm256_or_si256 (la, lb)))
+        ){
+            compare_columns (r, a, b, i, i + 4);
+            continue;
+        }
+        memcpy (&sa, a->s + i, 4);
+        memcpy (&sb, b->s + i, 4);
+        na = lanes_from_bytes_avx2 (sa);
+        nb = lanes_from_bytes_avx2 (sb);
+        la = _mm256_sub_epi64 (_mm256_xor_si256 (la, na), na);
+        lb = _mm256_sub_epi64 (_mm256_xor_si256 (lb, nb), nb);
+        gt = BITS_TO_BYTES_4 (_mm256_movemask_pd (_mm256_castsi256_pd (_mm256_cmpgt_epi64 (la, lb))));
+        lt = BITS_TO_BYTES_4 (_mm256_movemask_pd (_mm256_castsi256_pd (_mm256_cmpgt_epi64 (lb, la))));
+        gt |= lt * 0xFFu;
+        memcpy (r + i, &gt, 4);
     }
-
-    /* shift the remainder back to the right */
-    c[m] = 0;
-    for (j = 0; j < m; j++) r[j] = c[j] >> (31 - i);
-    for (j = 0; j < m; j++) r[j] |= c[j + 1] << (i + 1);
+    compare_columns (r, a, b, i, n);
 }
 
-/* uses double arithmetic */
-deci deci_divide(deci a, deci b) {
-    int32_t e = a.e - b.e, f = 0;
-    deci c;
-    uint32_t q[] = {0, 0, 0, 0, 0, 0}, r[4];
-    uint32_t sa[] = {a.m0, a.m1, a.m2, 0, 0, 0}, sb[] = {b.m0, b.m1, b.m2, 0};
-    double a_dbl, b_dbl, l10;
-    int32_t shift, na, nb, tc;
+/*
+    32 values per step; nonzero values only get k added to their exponents
+    if the results are in range, zeros get exponent 0;
+    any other case in a block is left to the scalar loop;
+*/
+__attribute__((target("avx2")))
+static uint32_t ldexp_columns_avx2 (const deci_columns *c, const deci_columns *a, int32_t k, size_t n) {
+    const __m256i limit = _mm256_set1_epi8 ((char)(k >= 0 ? 127 - k : -128 - k));
+    const __m256i bits = _mm256_set1_epi64x ((int64_t) 0x8040201008040201u);
+    const __m256i spread = _mm256_setr_epi64x (
+        0x0000000000000000, 0x0101010101010101, 0x0202020202020202, 0x0303030303030303
+    );
+    uint32_t st = 0, zeros;
+    __m256i e, out, zero_bytes;
+    size_t i;
+    int32_t j;
 
-    if (deci_is_zero (b)) DIVIDE_BY_ZERO_ERROR;
+    if ((k > 255) || (k < -255)) return ldexp_columns (c, a, k, 0, n);
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        zeros = 0;
+        for (j = 0; j < 32; j += 4) {
+            __m256i lo = _mm256_loadu_si256 ((const __m256i *)(a->lo + i + j));
+            __m128i hi = _mm_loadu_si128 ((const __m128i *)(a->hi + i + j));
+            _mm256_storeu_si256 ((__m256i *)(c->lo + i + j), lo);
+            _mm_storeu_si128 ((__m128i *)(c->hi + i + j), hi);
+            lo = _mm256_cmpeq_epi64 (_mm256_or_si256 (lo, _mm256_cvtepu32_epi64 (hi)), _mm256_setzero_si256 ());
+            zeros |= (uint32_t) _mm256_movemask_pd (_mm256_castsi256_pd (lo)) << j;
+        }
+        zero_bytes = _mm256_shuffle_epi8 (_mm256_set1_epi32 ((int) zeros), spread);
+        zero_bytes = _mm256_cmpeq_epi8 (_mm256_and_si256 (zero_bytes, bits), bits);
+        e = _mm256_loadu_si256 ((const __m256i *)(a->e + i));
+        out = k >= 0 ? _mm256_cmpgt_epi8 (e, limit) : _mm256_cmpgt_epi8 (limit, e);
+        if (_mm256_movemask_epi8 (_mm256_andnot_si256 (zero_bytes, out))) {
+            st |= ldexp_columns (c, a, k, i, i + 32);
+            continue;
+        }
+        e = _mm256_andnot_si256 (zero_bytes, _mm256_add_epi8 (e, _mm256_set1_epi8 ((char) k)));
+        _mm256_storeu_si256 ((__m256i *)(c->e + i), e);
+        if (c->s != a->s) memcpy (c->s + i, a->s + i, 32);
+    }
+    return st | ldexp_columns (c, a, k, i, n);
+}
 
-    /* compute sign */
-    c.s = (!a.s && b.s) || (a.s && !b.s);
+#ifndef DECI_NO_AVX512
 
-    if (deci_is_zero (a)) {
-        c.m0 = 0;
-        c.m1 = 0;
-        c.m2 = 0;
-        c.e = 0;
-        return c;
+/* 0 or 1 in each of 8 bytes to a lane mask */
+__attribute__((target("avx512f,avx512bw")))
+INLINE __mmask8 mask_from_bytes_avx512 (uint64_t x) {
+    return (__mmask8) _mm_movemask_epi8 (_mm_cvtsi64_si128 ((int64_t)(x << 7)));
+}
+
+/* 8 values per step, as add_columns_avx2() */
+__attribute__((target("avx512f,avx512bw")))
+static uint32_t add_columns_avx512 (const deci_columns *c, const deci_columns *a, const deci_columns *b, bool sub, size_t n) {
+    uint32_t st = 0;
+    uint64_t ea, eb, sa, sb;
+    __mmask8 same, lt, sel, s;
+    __m512i la, lb, sum, diff;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        memcpy (&ea, a->e + i, 8);
+        memcpy (&eb, b->e + i, 8);
+        __m256i h = _mm256_or_si256 (
+            _mm256_loadu_si256 ((const __m256i *)(a->hi + i)),
+            _mm256_loadu_si256 ((const __m256i *)(b->hi + i))
+        );
+        if ((ea != eb) || !_mm256_testz_si256 (h, h)) {
+            st |= add_columns (c, a, b, sub, i, i + 8);
+            continue;
+        }
+        memcpy (&sa, a->s + i, 8);
+        memcpy (&sb, b->s + i, 8);
+        if (sub) sb ^= 0x0101010101010101u;
+        same = (__mmask8) ~mask_from_bytes_avx512 (sa ^ sb);
+        la = _mm512_loadu_si512 (a->lo + i);
+        lb = _mm512_loadu_si512 (b->lo + i);
+        sum = _mm512_add_epi64 (la, lb);
+        if (_mm512_mask_cmplt_epu64_mask (same, sum, la)) {
+            st |= add_columns (c, a, b, sub, i, i + 8);
+            continue;
+        }
+        lt = _mm512_cmplt_epu64_mask (la, lb);
+        diff = _mm512_mask_sub_epi64 (_mm512_sub_epi64 (la, lb), lt, lb, la);
+        sel = (__mmask8)(~same & lt);
+        s = (__mmask8)((mask_from_bytes_avx512 (sa) & ~sel) | (mask_from_bytes_avx512 (sb) & sel));
+        sa = BITS_TO_BYTES_8 (s);
+        _mm512_storeu_si512 (c->lo + i, _mm512_mask_blend_epi64 (same, diff, sum));
+        _mm256_storeu_si256 ((__m256i *)(c->hi + i), _mm256_setzero_si256 ());
+        memcpy (c->e + i, &ea, 8);
+        memcpy (c->s + i, &sa, 8);
     }
+    return st | add_columns (c, a, b, sub, i, n);
+}
 
-    /* compute decimal shift needed to obtain the highest accuracy */
-    a_dbl = (a.m2 * two_to_32 + a.m1) * two_to_32 + a.m0;
-    b_dbl = (b.m2 * two_to_32 + b.m1) * two_to_32 + b.m0;
-    l10 = log10 (a_dbl);
-    shift = (int32_t)ceil (25.5 + log10(b_dbl) - l10);
-    dsl (3, sa, shift);
-    e -= shift;
+/* 8 values per step, as compare_columns_avx2() */
+__attribute__((target("avx512f,avx512bw")))
+static void compare_columns_avx512 (int8_t r[], const deci_columns *a, const deci_columns *b, size_t n) {
+    const __m512i top = _mm512_set1_epi64 (INT64_MIN);
+    uint64_t ea, eb, sa, sb, gt;
+    __m512i la, lb;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        memcpy (&ea, a->e + i, 8);
+        memcpy (&eb, b->e + i, 8);
+        __m256i h = _mm256_or_si256 (
+            _mm256_loadu_si256 ((const __m256i *)(a->hi + i)),
+            _mm256_loadu_si256 ((const __m256i *)(b->hi + i))
+        );
+        la = _mm512_loadu_si512 (a->lo + i);
+        lb = _mm512_loadu_si512 (b->lo + i);
+        if ((ea != eb) || !_mm256_testz_si256 (h, h) || _mm512_test_epi64_mask (_mm512_or_si512 (la, lb), top)) {
+            compare_columns (r, a, b, i, i + 8);
+            continue;
+        }
+        memcpy (&sa, a->s + i, 8);
+        memcpy (&sb, b->s + i, 8);
+        la = _mm512_mask_sub_epi64 (la, mask_from_bytes_avx512 (sa), _mm512_setzero_si512 (), la);
+        lb = _mm512_mask_sub_epi64 (lb, mask_from_bytes_avx512 (sb), _mm512_setzero_si512 (), lb);
+        gt = BITS_TO_BYTES_8 (_mm512_cmpgt_epi64_mask (la, lb))
+            | BITS_TO_BYTES_8 (_mm512_cmplt_epi64_mask (la, lb)) * 0xFFu;
+        memcpy (r + i, &gt, 8);
+    }
+    compare_columns (r, a, b, i, n);
+}
 
-    /* count radix 2 ** 32 digits of the shifted significand sa */
-    na = (int32_t)ceil ((l10 + shift) * 0.10381025296523 + 0.5);
-    if (sa[na - 1] == 0) na--;
+/* 64 values per step, as ldexp_columns_avx2() */
+__attribute__((target("avx512f,avx512bw")))
+static uint32_t ldexp_columns_avx512 (const deci_columns *c, const deci_columns *a, int32_t k, size_t n) {
+    const __m512i limit = _mm512_set1_epi8 ((char)(k >= 0 ? 127 - k : -128 - k));
+    uint32_t st = 0;
+    uint64_t zeros;
+    __mmask64 out;
+    __m512i e;
+    size_t i;
+    int32_t j;
 
-    nb = b.m2 ? 3 : (b.m1 ? 2 : 1);
-    m_divide (q, r, na, sa, nb, sb);
+    if ((k > 255) || (k < -255)) return ldexp_columns (c, a, k, 0, n);
+
+    for (i = 0; i + 64 <= n; i += 64) {
+        zeros = 0;
+        for (j = 0; j < 64; j += 8) {
+            __m512i lo = _mm512_loadu_si512 (a->lo + i + j);
+            __m256i hi = _mm256_loadu_si256 ((const __m256i *)(a->hi + i + j));
+            _mm512_storeu_si512 (c->lo + i + j, lo);
+            _mm256_storeu_si256 ((__m256i *)(c->hi + i + j), hi);
+            zeros |= (uint64_t) _mm512_testn_epi64_mask (
+                _mm512_or_si512 (lo, _mm512_cvtepu32_epi64 (hi)), _mm512_set1_epi64 (-1)
+            ) << j;
+        }
+        e = _mm512_loadu_si512 (a->e + i);
+        out = k >= 0 ? _mm512_cmpgt_epi8_mask (e, limit) : _mm512_cmpgt_epi8_mask (limit, e);
+        if (out & ~zeros) {
+            st |= ldexp_columns (c, a, k, i, i + 64);
+            continue;
+        }
+        _mm512_storeu_si512 (c->e + i, _mm512_maskz_add_epi8 (~zeros, e, _mm512_set1_epi8 ((char) k)));
+        if (c->s != a->s) memcpy (c->s + i, a->s + i, 64);
+    }
+    return st | ldexp_columns (c, a, k, i, n);
+}
 
-    /* compute the truncate flag */
-    m_multiply_1 (nb, r, r, 2);
-    tc = m_cmp (nb + 1, r, sb);
-    if (tc >= 0) tc = tc == 0 ? 2 : 3;
-    else tc = m_is_zero (nb + 1, r) ? 0 : 1;
+#endif
 
-    /* normalize the significand q */
-    shift = min_shift_right (q);
-    if (shift > 0) {
-        dsr (3, q, shift, &tc);
-        e += shift;
+/* 2 with AVX-512, 1 with AVX2, else 0; decided once */
+static int32_t simd_level (void) {
+    static int32_t level = -1;
+    if (level < 0) {
+        __builtin_cpu_init ();
+#ifndef DECI_NO_AVX512
+        if (__builtin_cpu_supports ("avx512f") && __builtin_cpu_supports ("avx512bw")) level = 2;
+        else
+#endif
+        level = __builtin_cpu_supports ("avx2") ? 1 : 0;
     }
+    return level;
+}
 
-    /* round q if needed */
-    if (((tc == 3) || ((tc == 2) && (q[0] % 2 == 1))) && (e >= -128)) m_add_1 (q, 1);
+#endif
 
-    m_ldexp (q, &f, e, tc);
-    c.m0 = q[0];
-    c.m1 = q[1];
-    c.m2 = q[2];
-    c.e = f;
-    return c;
+/*
+    c = a + b for the first n values of the columns, c may be a or b;
+    returns the status flags, see deci_add_checked();
+*/
+uint32_t deci_columns_add_n (const deci_columns *c, const deci_columns *a, const deci_columns *b, size_t n) {
+#ifdef DECI_SIMD
+    switch (simd_level ()) {
+#ifndef DECI_NO_AVX512
+    case 2: return add_columns_avx512 (c, a, b, false, n);
+#endif
+    case 1: return add_columns_avx2 (c, a, b, false, n);
+    }
+#endif
+    return add_columns (c, a, b, false, 0, n);
 }
 
-#define MAX_NB 7
+uint32_t deci_columns_subtract_n (const deci_columns *c, const deci_columns *a, const deci_columns *b, size_t n) {
+#ifdef DECI_SIMD
+    switch (simd_level ()) {
+#ifndef DECI_NO_AVX512
+    case 2: return add_columns_avx512 (c, a, b, true, n);
+#endif
+    case 1: return add_columns_avx2 (c, a, b, true, n);
+    }
+#endif
+    return add_columns (c, a, b, true, 0, n);
+}
 
-INLINE int32_t m_to_string(Byte* s, uint32_t n, const uint32_t a[]) {
-    uint32_t r, b[MAX_NB];
-    Byte v[10 * MAX_NB + 1], *vmax, *k;
+/* r[i] = deci_compare (a[i], b[i]) for the first n values of the columns */
+void deci_columns_compare_n (int8_t r[], const deci_columns *a, const deci_columns *b, size_t n) {
+#ifdef DECI_SIMD
+    switch (simd_level ()) {
+#ifndef DECI_NO_AVX512
+    case 2: compare_columns_avx512 (r, a, b, n); return;
+#endif
+    case 1: compare_columns_avx2 (r, a, b, n); return;
+    }
+#endif
+    compare_columns (r, a, b, 0, n);
+}
 
-    /* finds the first nonzero radix 2 ** 32 "digit" */
-    for (; (n > 0) && (a[n - 1] == 0); n--);
+/*
+    c = a * (10 ** k) for the first n values of the columns, c may be a;
+    returns the status flags, underflow gives zeros as in deci_ldexp();
+*/
+uint32_t deci_columns_ldexp_n (const deci_columns *c, const deci_columns *a, int32_t k, size_t n) {
+#ifdef DECI_SIMD
+    switch (simd_level ()) {
+#ifndef DECI_NO_AVX512
+    case 2: return ldexp_columns_avx512 (c, a, k, n);
+#endif
+    case 1: return ldexp_columns_avx2 (c, a, k, n);
+    }
+#endif
+    return ldexp_columns (c, a, k, 0, n);
+}
 
-    if (n == 0) {
-        s[0] = '0';
-        s[1] = '\0';
-        return 1;
+/* two-digit strings for the numbers 0 to 99 */
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Writes exactly k <= 9 decimal digits of c to s, most significant first */
+INLINE void put_digits (Byte *s, uint32_t c, int32_t k) {
+    for (s += k; k >= 2; k -= 2) {
+        s -= 2;
+        memcpy (s, DIGIT_PAIRS + 2 * (c % 100), 2);
+        c /= 100;
     }
+    if (k) *--s = '0' + c;
+}
 
-    /* copy a to preserve it */
-    memcpy (b, a, n * sizeof (uint32_t));
+/* Writes integer i to s, no terminator; returns the end */
+INLINE Byte *put_int (Byte *s, int32_t i) {
+    uint32_t u = i < 0 ? -(uint32_t) i : (uint32_t) i;
+    int32_t k;
+    if (i < 0) *s++ = '-';
+    for (k = 1; (k < 10) && (u >= P[k][0]); k++) NOOP;
+    put_digits (s, u, k);
+    return s + k;
+}
 
-    k = vmax = v + 10 * MAX_NB;
-    *k = '\0';
-    while (n > 0) {
-        r = m_divide_1 (n, b, b, 10u);
-        if (b[n - 1] == 0) n--;
-        *--k = '0' + r;
+/*
+    Writes exactly j digits of significand a to s, no terminator;
+    the digits are peeled in chunks of 9, each emitted two at a time
+*/
+INLINE void m_to_string (Byte *s, const uint64_t a[2], int32_t j) {
+    uint64_t q[2], r;
+
+    if (j > 18) {
+        r = m_divide_pow10 (2, q, a, 18);
+        put_digits (s, (uint32_t) q[0], j - 18);
+        s += j - 18;
+        j = 18;
+    } else r = a[0];
+
+    if (j > 9) {
+        put_digits (s, (uint32_t)(r / 1000000000u), j - 9);
+        s += j - 9;
+        r %= 1000000000u;
+        j = 9;
     }
-
-    strcpy((char*)s, (char*)k);  // requires cast, see [D]
-    return vmax - k;
+    put_digits (s, (uint32_t) r, j);
 }
 
 int32_t deci_to_string (Byte *string, const deci a, const Byte symbol, const Byte point) {
     Byte *s = string;
-    uint32_t sa[] = {a.m0, a.m1, a.m2};
-    int32_t j, e;
+    uint64_t sa[] = {M_LO(a), M_HI(a)};
+    int32_t j, e, k;
 
     /* sign */
     if (a.s) *s++ = '-';
@@ -1167,102 +3678,166 @@ int32_t deci_to_string (Byte *string, const deci a, const Byte symbol, const Byt
         return s-string;
     }
 
-    j = m_to_string(s, 3, sa);
+    j = m_digits (sa);
     e = j + a.e;
 
-    if (e < j) {
-        if (e <= 0) {
-            if (e < -6) {
-                s++;
-                if (j > 1) {
-                    memmove(s + 1, s, j);
-                    *s = point;
-                    s += j;
-                }
-                *s++ = 'e';
-                INT_TO_STR(e - 1, s);
-                s = (Byte*)strchr((char*)s, '\0');  // requires casts, see [D]
-            } else { /* -6 <= e <= 0 */
-                memmove(s + 2 - e, s, j + 1);
-                *s++ = '0';
-                *s++ = point;
-                memset(s, '0', -e);
-                s += j - e;
-            }
-        } else { /* 0 < e < j */
-            s += e;
-            memmove(s + 1, s, j - e + 1);
-            *s++ = point;
-            s += j - e;
-        }
-    } else if (e == j) {
+    if ((e <= 0) && (e >= -6)) {
+        /* 0.000ddd */
+        *s++ = '0';
+        *s++ = point;
+        memset (s, '0', -e);
+        s -= e;
+        m_to_string (s, sa, j);
         s += j;
-    } else { /* j < e */
+    } else if ((e < -6) || ((e > 0) && (e < j))) {
+        /* d.ddde-x or dd.ddd, the digits before the point are moved left */
+        k = e < 0 ? 1 : e;
+        if (j > k) {
+            m_to_string (s + 1, sa, j);
+            memmove (s, s + 1, k);
+            s[k] = point;
+            s += j + 1;
+        } else {
+            m_to_string (s, sa, j);
             s += j;
+        }
+        if (e < -6) {
+            *s++ = 'e';
+            s = put_int (s, e - 1);
+        }
+    } else {
+        /* ddd or ddde+x */
+        m_to_string (s, sa, j);
+        s += j;
+        if (j < e) {
             *s++ = 'e';
-            INT_TO_STR(e - j, s);
-            s = (Byte*)strchr((char*)s, '\0');  // requires casts, see [D]
+            s = put_int (s, e - j);
+        }
     }
 
+    *s = '\0';
     return s - string;
 }
 
+/*
+    Computes the remainder of a modulo b;
+    for a.e > b.e that is the remainder of sa * 10 ** (a.e - b.e), a gap of
+    up to 255 digits; a remainder times 10 ** MOD_SHIFT still fits in MAX_N
+    limbs, so a gap of up to MOD_SHIFT digits takes one shift and division,
+    and a larger one is reduced MOD_SHIFT digits at a time by the divisor
+    prepared once, in at most 5 steps without a division instruction;
+*/
+#define MOD_SHIFT 51
+
 deci deci_mod (deci a, deci b) {
-    uint32_t sa[] = {a.m0, a.m1, a.m2};
-    uint32_t sb[] = {b.m0, b.m1, b.m2,0}; /* the additional place is for dsl */
-    uint32_t sc[] = {10u, 0, 0};
-    uint32_t p[6]; /* for multiplication results */
-    int32_t e, nb;
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0, 0, 0}; /* the places are for dsl */
+    uint64_t q[MAX_N];
+    deci_divisor p;
+    int32_t e, shift, na;
 
     if (deci_is_zero (b)) DIVIDE_BY_ZERO_ERROR;
     if (deci_is_zero (a)) return deci_zero;
 
+    p.b[0] = M_LO(b);
+    p.b[1] = M_HI(b);
+    p.b[2] = 0; /* the additional place is for dsl */
+
     e = a.e - b.e;
     if (e < 0) {
-        if (max_shift_left (sb) < -e) return a; /* a < b */
-        dsl (3, sb, -e);
+        if (max_shift_left (p.b) < -e) return a; /* a < b */
+        dsl (2, p.b, -e);
         b.e = a.e;
         e = 0;
     }
     /* e >= 0 */
 
-    /* count radix 2 ** 32 digits of sb */
-    nb = sb[2] ? 3 : (sb[1] ? 2 : 1);
+    /* count radix 2 ** 64 digits of sb */
+    p.n = p.b[1] ? 2 : 1;
 
-    /* sa = remainder(sa, sb) */
-    m_divide (p, sa, 3, sa, nb, sb);
-
-    while (e > 0) {
-        /* invariants:
-            computing remainder (sa * pow (sc, e), sb)
-            sa has nb radix pow (2, 32) digits
-        */
-        if (e % 2) {
-            /* sa = remainder (sa * sc, sb) */
-            m_multiply (p, nb, sa, nb, sc);
-            m_divide (p, sa, nb + nb, p, nb, sb);
-            e--;
-        } else {
-            /* sc = remainder (sc * sc, sb) */
-            m_multiply (p, nb, sc, nb, sc);
-            m_divide (p, sc, nb + nb, p, nb, sb);
-            e /= 2;
+    if (e <= MOD_SHIFT) {
+        /* sa = remainder (sa * pow (10, e), sb) */
+        dsl (2, sa, e);
+        for (na = MAX_N; (na > 2) && (sa[na - 1] == 0); na--) NOOP;
+        m_divide (q, sa, na, sa, p.n, p.b);
+    } else {
+        prepare_reciprocal (&p);
+        for (; e > 0; e -= shift) {
+            /* sa = remainder (sa * pow (10, shift), sb) */
+            shift = e < MOD_SHIFT ? e : MOD_SHIFT;
+            dsl (2, sa, shift);
+            for (na = MAX_N; (na > 2) && (sa[na - 1] == 0); na--) NOOP;
+            m_divide_prepared (q, sa, na, sa, &p);
+            sa[2] = sa[3] = sa[4] = 0;
+            if (p.n < 2) sa[1] = 0;
         }
     }
-    /* e = 0 */
 
-    a.m0 = sa[0];
-    a.m1 = nb >= 2 ? sa[1] : 0;
-    a.m2 = nb == 3 ? sa[2] : 0;
+    if (p.n < 2) sa[1] = 0;
+    m_to_deci (&a, sa);
     a.e = b.e;
     return a;
 }
 
+#define SWAR_ONES 0x0101010101010101u
+#define SWAR_HIGH 0x8080808080808080u
+
+/* Loads 8 bytes, the first one in the least significant byte */
+INLINE uint64_t load_8 (const Byte *a) {
+    uint64_t x;
+    memcpy (&x, a, sizeof (x));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    x = __builtin_bswap64 (x);
+#endif
+    return x;
+}
+
+/* Marks the bytes of x holding a digit with their high bit, exactly */
+INLINE uint64_t digit_bytes (uint64_t x) {
+    uint64_t y = x & ~SWAR_HIGH;
+    uint64_t ge0 = y + (0x80 - '0') * SWAR_ONES;
+    uint64_t gt9 = y + (0x80 - '9' - 1) * SWAR_ONES;
+    return ge0 & ~gt9 & ~x & SWAR_HIGH;
+}
+
+/* Converts 8 digit bytes to their value, see Lemire's fast_float */
+INLINE uint32_t swar_8_digits (uint64_t x) {
+    x -= '0' * SWAR_ONES;
+    x = x * 10 + (x >> 8);
+    return (uint32_t)(((x & 0x000000FF000000FFu) * (100 + ((uint64_t) 1000000 << 32))
+        + ((x >> 16 & 0x000000FF000000FFu) * (1 + ((uint64_t) 10000 << 32)))) >> 32);
+}
+
+/*
+    Finds the end of the run of digits and ' separators at a;
+    only the bytes of the run are loaded 8 at a time, so nothing past the
+    terminator is read
+*/
+INLINE const Byte *digit_run_end (const Byte *a) {
+    while (IS_DIGIT(*a) || ('\'' == *a)) a++;
+    return a;
+}
+
+/*
+    Converts 8 bytes of digits and ' separators at a;
+    returns the number of digits, their value in *u
+*/
+INLINE int32_t swar_8_grouped (const Byte *a, uint64_t *u) {
+    int32_t i, c = 0;
+    *u = 0;
+    for (i = 0; i < 8; i++)
+        if (a[i] != '\'') {
+            *u = *u * 10 + (a[i] - '0');
+            c++;
+        }
+    return c;
+}
+
 /* in case of error the function returns deci_zero and *endptr = s */
 deci string_to_deci (const Byte* s, const Byte* *endptr) {
     const Byte* a = s;
+    const Byte* run; /* end of the digit run at a, once scanned */
     deci b = {0, 0, 0, 0, 0};
-    uint32_t sb[] = {0, 0, 0, 0}; /* significand */
+    uint64_t sb[] = {0, 0, 0}; /* significand */
     int32_t f = 0, e = 0; /* exponents */
     int32_t fp = 0; /* full precision flag */
     int32_t dp = 0; /* decimal point encountered */
@@ -1280,12 +3855,33 @@ deci string_to_deci (const Byte* s, const Byte* *endptr) {
     if ('$' == *a) a++;
 
     /* significand */
-    for (; ; a++)
+    for (run = a; ; a++) {
+        /*
+            while the significand is below 10^18, 8 more digits fit, so runs
+            of digits and separators are taken 8 bytes at a time
+        */
+        if ((sb[1] == 0) && (sb[0] < P[18][0]) && (run <= a)) run = digit_run_end (a);
+        while ((sb[1] == 0) && (sb[0] < P[18][0]) && (run - a >= 8)) {
+            uint64_t x = load_8 (a), u;
+            uint128_t t;
+            int32_t c;
+            if (digit_bytes (x) == SWAR_HIGH) {
+                u = swar_8_digits (x);
+                c = 8;
+            } else c = swar_8_grouped (a, &u);
+            t = (uint128_t) sb[0] * P[c][0] + u;
+            sb[0] = MASK64(t);
+            sb[1] = (uint64_t)(t >> 64);
+            if (dp) f -= c;
+            a += 8;
+        }
+
         if (IS_DIGIT(*a)) {
             d = *a - '0';
-            if (m_cmp (3, sb, P[25]) < 0) {
-                m_multiply_1 (3, sb, sb, 10u);
-                m_add_1 (sb, d);
+            if (m_cmp (2, sb, P[25]) < 0) {
+                uint128_t t = ((uint128_t) sb[1] << 64 | sb[0]) * 10u + d;
+                sb[0] = MASK64(t);
+                sb[1] = (uint64_t)(t >> 64);
                 if (dp) f--;
             } else {
                 if (fp) {
@@ -1305,6 +3901,7 @@ deci string_to_deci (const Byte* s, const Byte* *endptr) {
             }
             else dp = 1;
         } else if ('\'' != *a) break;
+    }
 
     /* exponent */
     if (('e' == *a) || ('E' == *a)) {
@@ -1333,23 +3930,141 @@ deci string_to_deci (const Byte* s, const Byte* *endptr) {
 
     /* round */
     if (((tb == 3) || ((tb == 2) && (sb[0] % 2 == 1))) && (e >= -128)) {
-        if (m_cmp (3, sb, P26_1) < 0) m_add_1 (sb, 1);
+        if (m_cmp (2, sb, P26_1) < 0) m_add_1 (sb, 1);
         else {
-            dsr (3, sb, 1, &tb);
+            dsr (2, sb, 1, &tb);
             e++;
             if ((tb == 3) || ((tb == 2) && (sb[0] % 2 == 1))) m_add_1 (sb, 1);
         }
     }
 
-    m_ldexp (sb, &f, e, tb);
+    m_ldexp (sb, &f, e, tb, NULL);
 
-    b.m0 = sb[0];
-    b.m1 = sb[1];
-    b.m2 = sb[2];
+    m_to_deci (&b, sb);
     b.e = f;
     return b;
 }
 
+/*
+    Rounds a to a multiple of 10 ** e in one decimal shift, like the
+    rounding function of mode does with b = 10 ** e, bit for bit;
+    the digits below 10 ** e are dropped with their truncate flag, and the
+    mode decides from it whether the kept significand is incremented;
+    the result is then expressed with the lowest exponent down to f <= e
+    it fits in, as the functions leave it with the exponent of b;
+*/
+INLINE deci quantize_deci (deci a, int32_t e, int32_t f, int32_t mode) {
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0};
+    int32_t ta = 0, shift;
+    bool up;
+
+    if (deci_is_zero (a)) {
+        /* the functions add a zero with exponent 0 */
+        if (a.e > 0) a.e = 0;
+        if (a.e < f) a.e = f;
+        return a;
+    }
+
+    if (a.e < e) {
+        shift = e - a.e;
+        if (shift > 26) {
+            /* less than half of 10 ** e */
+            sa[0] = 0;
+            sa[1] = 0;
+            ta = 1;
+        } else dsr (2, sa, shift, &ta);
+
+        switch (mode) {
+          case DECI_ROUND_TRUNCATE: up = false; break;
+          case DECI_ROUND_AWAY: up = ta != 0; break;
+          case DECI_ROUND_FLOOR: up = (ta != 0) && a.s; break;
+          case DECI_ROUND_CEIL: up = (ta != 0) && !a.s; break;
+          case DECI_ROUND_HALF_EVEN: up = (ta == 3) || ((ta == 2) && (sa[0] % 2 == 1)); break;
+          case DECI_ROUND_HALF_AWAY: up = ta >= 2; break;
+          case DECI_ROUND_HALF_TRUNCATE: up = ta == 3; break;
+          case DECI_ROUND_HALF_CEIL: up = (ta == 3) || ((ta == 2) && !a.s); break;
+          case DECI_ROUND_HALF_FLOOR: up = (ta == 3) || ((ta == 2) && a.s); break;
+          default: assert (false); up = false;
+        }
+
+        if (up) {
+            m_add_1 (sa, 1);
+            if (m_cmp (2, sa, P[26]) == 0) {
+                /* 1e26 has to be 1e25 with the next exponent */
+                if (e == 127) OVERFLOW_ERROR;
+                sa[0] = P[25][0];
+                sa[1] = P[25][1];
+                e++;
+            }
+        }
+        a.e = e;
+
+        if (m_is_zero (2, sa)) {
+            a.m0 = 0;
+            a.m1 = 0;
+            a.m2 = 0;
+            a.e = f;
+            return a;
+        }
+    }
+
+    /* a multiple of 10 ** e, with the lowest exponent down to f it fits */
+    if (a.e > f) {
+        shift = 26 - m_digits (sa);
+        if (shift > a.e - f) shift = a.e - f;
+        dsl (2, sa, shift);
+        a.e -= shift;
+    }
+    m_to_deci (&a, sa);
+    return a;
+}
+
+/*
+    Rounds a to a multiple of 10 ** e in mode, one of the DECI_ROUND_...
+    values; e must be a deci exponent, -128 to 127;
+*/
+deci deci_quantize (deci a, int32_t e, int32_t mode) {
+    assert ((e >= -128) && (e <= 127));
+    return quantize_deci (a, e, e, mode);
+}
+
+/* Finds out if |a| is 10 ** e, storing e */
+INLINE bool is_power_of_ten (deci a, int32_t *e) {
+    uint64_t sa[] = {M_LO(a), M_HI(a)};
+    int32_t j;
+
+    if (deci_is_zero (a)) return false;
+    j = m_digits (sa) - 1;
+    if (m_cmp (2, sa, P[j]) != 0) return false;
+    *e = a.e + j;
+    return true;
+}
+
+/*
+    Rounds a to a multiple of |b| in mode, like the rounding functions;
+    a power of ten b takes deci_quantize's single decimal shift;
+*/
+deci deci_round (deci a, deci b, int32_t mode) {
+    int32_t e;
+
+    b.s = 0;
+    if (is_power_of_ten (b, &e) && (e <= 127)) return quantize_deci (a, e, b.e, mode);
+
+    switch (mode) {
+      case DECI_ROUND_TRUNCATE: return deci_truncate (a, b);
+      case DECI_ROUND_AWAY: return deci_away (a, b);
+      case DECI_ROUND_FLOOR: return deci_floor (a, b);
+      case DECI_ROUND_CEIL: return deci_ceil (a, b);
+      case DECI_ROUND_HALF_EVEN: return deci_half_even (a, b);
+      case DECI_ROUND_HALF_AWAY: return deci_half_away (a, b);
+      case DECI_ROUND_HALF_TRUNCATE: return deci_half_truncate (a, b);
+      case DECI_ROUND_HALF_CEIL: return deci_half_ceil (a, b);
+      case DECI_ROUND_HALF_FLOOR: return deci_half_floor (a, b);
+    }
+    assert (false);
+    return a;
+}
+
 deci deci_sign (deci a) {
     if (deci_is_zero (a)) return a;
     if (a.s) return deci_minus_one; else return deci_one;
@@ -1360,8 +4075,9 @@ bool deci_is_same (deci a, deci b) {
     return (a.m0 == b.m0) && (a.m1 == b.m1) && (a.m2 == b.m2) && (a.s == b.s) && (a.e == b.e);
 }
 
-deci binary_to_deci (const Byte s[12]) {
+INLINE deci bytes_to_deci (const Byte s[12], uint32_t *st) {
     deci d;
+    bool overflow = false;
     /* this looks like the only way, since the order of bits in bitsets is compiler-dependent */
     d.s = s[0] >> 7;
     d.e = s[0] << 1 | s[1] >> 7;
@@ -1371,12 +4087,27 @@ deci binary_to_deci (const Byte s[12]) {
     /* validity checks */
     if (d.m2 >= 5421010u) {
         if (d.m1 >= 3704098002u) {
-            if (d.m0 > 3825205247u || d.m1 > 3704098002u) OVERFLOW_ERROR;
-        } else if (d.m2 > 5421010u) OVERFLOW_ERROR;
+            overflow = d.m0 > 3825205247u || d.m1 > 3704098002u;
+        } else overflow = d.m2 > 5421010u;
+    }
+    if (overflow) {
+        raise_status (st, DECI_OVERFLOW);
+        return deci_zero;
     }
     return d;
 }
 
+deci binary_to_deci (const Byte s[12]) {
+    return bytes_to_deci (s, NULL);
+}
+
+/* binary_to_deci returning DECI_OVERFLOW for an invalid significand */
+uint32_t binary_to_deci_checked (deci *c, const Byte s[12]) {
+    uint32_t st = 0;
+    *c = bytes_to_deci (s, &st);
+    return st;
+}
+
 Byte* deci_to_binary (Byte s[12], const deci d) {
     /* this looks like the only way, since the order of bits in bitsets is compiler-dependent */
     s[0] = d.s << 7 | (Byte)d.e >> 1;
@@ -1393,3 +4124,354 @@ Byte* deci_to_binary (Byte s[12], const deci d) {
     s[11] = d.m0 & 0xFF;
     return s;
 }
+
+/*
+    Sort key: a 96-bit number, stored big-endian, whose order is the order
+    of the values, so memcmp of two keys compares the decis like
+    deci_compare, equal decis getting the same key;
+    a nonzero value is the significand m scaled to 26 digits, 1e25 <= m <
+    1e26, with the exponent t of its highest digit, -127 <= t <= 153, and
+    x = (t + 127) * 9e25 + m - 1e25 < 281 * 9e25 < 2 ** 95 orders them;
+    the key is 2 ** 95 + 1 + x for positive values, 2 ** 95 - 1 - x for
+    negative ones and 2 ** 95 for zero;
+*/
+Byte *deci_to_key (Byte key[12], const deci a) {
+    const uint128_t e25 = (uint128_t) P[25][1] << 64 | P[25][0];
+    uint64_t sa[] = {M_LO(a), M_HI(a), 0};
+    uint128_t k = (uint128_t) 1 << 95, x;
+    int32_t d, i;
+
+    if (!m_is_zero (2, sa)) {
+        d = m_digits (sa);
+        dsl (2, sa, 26 - d);
+        x = (uint128_t)(a.e + d + 127) * (9 * e25) + (((uint128_t) sa[1] << 64 | sa[0]) - e25);
+        k = a.s ? k - 1 - x : k + 1 + x;
+    }
+    for (i = 11; i >= 0; i--) {
+        key[i] = (Byte) k;
+        k >>= 8;
+    }
+    return key;
+}
+
+/*
+    Stable sort of a[] by value: a least significant digit radix sort of
+    the sort keys, a byte per pass; the counts for all the passes are made
+    in one sweep, and a pass is skipped when all the keys share the byte;
+    t is scratch space for 2 * n items;
+*/
+void deci_sort_n (deci a[], size_t n, deci_sort_item t[]) {
+    size_t count[12][256];
+    deci_sort_item *from = t, *to = t + n, *swap;
+    size_t i, sum, c;
+    int32_t j, k;
+
+    memset (count, 0, sizeof (count));
+    for (i = 0; i < n; i++) {
+        deci_to_key (t[i].key, a[i]);
+        t[i].d = a[i];
+        for (j = 0; j < 12; j++) count[j][t[i].key[j]]++;
+    }
+
+    for (j = 11; j >= 0; j--) {
+        if (n == 0 || count[j][from[0].key[j]] == n) continue;
+        /* counts to starting positions */
+        for (sum = 0, k = 0; k < 256; k++) {
+            c = count[j][k];
+            count[j][k] = sum;
+            sum += c;
+        }
+        for (i = 0; i < n; i++) to[count[j][from[i].key[j]]++] = from[i];
+        swap = from;
+        from = to;
+        to = swap;
+    }
+
+    for (i = 0; i < n; i++) a[i] = from[i].d;
+}
+
+/*
+    Exact accumulator: the sums of the positive and of the negative terms
+    are kept separately as fixed-point numbers in units of 10 ** -256, the
+    lowest digit of a product of decis, in radix 10 ** 19 limbs, so adding
+    a deci or an exact product of two never rounds; the difference is
+    rounded once, in deci_accumulator_result;
+    consecutive terms with the same exponent are first summed in binary,
+    in one 192-bit pending sum for each sign, and aligned only when the
+    exponent changes or the pending sum could overflow;
+*/
+
+#define E19 P[19][0]
+#define ACC_UNIT 256  /* position of 10 ** 0 in units */
+
+void deci_accumulator_init (deci_accumulator *acc) {
+    memset (acc, 0, sizeof (*acc));
+    acc->e = 255;
+}
+
+/*
+    Adds significand t with length n <= 4, its lowest digit at position u
+    in units, to l;
+    radix 10 ** 19 digits are added with 64-bit arithmetic;
+*/
+INLINE void acc_add (uint64_t l[], int32_t u, const uint64_t t[], int32_t n) {
+    uint64_t b[5], d, c = 0, s;
+    int32_t i = u / 19;
+
+    /* align: t * 10 ** (u % 19), converted to radix 10 ** 19 */
+    m_multiply_1 (n, b, t, P[u % 19][0]);
+    n++;
+    while ((n > 1) && (b[n - 1] == 0)) n--;
+
+    while (c || (n > 1) || b[0]) {
+        if (i == DECI_ACC_LIMBS) OVERFLOW_ERROR;
+        d = m_divide_pow10 (n, b, b, 19);
+        if ((n > 1) && (b[n - 1] == 0)) n--;
+        s = d + c;
+        if (l[i] >= E19 - s) {
+            l[i] -= E19 - s;
+            c = 1;
+        } else {
+            l[i] += s;
+            c = 0;
+        }
+        i++;
+    }
+}
+
+/* Moves the pending sums to the fixed-point ones */
+INLINE void acc_flush (deci_accumulator *acc) {
+    int32_t s;
+    for (s = 0; s < 2; s++)
+        if (acc->pending[s][0] || acc->pending[s][1] || acc->pending[s][2]) {
+            acc_add (s ? acc->n : acc->p, acc->pending_e + ACC_UNIT, acc->pending[s], 3);
+            memset (acc->pending[s], 0, sizeof (acc->pending[s]));
+        }
+}
+
+/* Adds the nonzero 128-bit significand hi:lo with sign s and exponent e */
+INLINE void acc_add_128 (deci_accumulator *acc, bool s, int32_t e, uint64_t lo, uint64_t hi) {
+    uint64_t *t = acc->pending[s];
+    uint128_t sum;
+
+    if (e < acc->e) acc->e = e;
+
+    if (e != acc->pending_e) {
+        acc_flush (acc);
+        acc->pending_e = e;
+    } else if (t[2] >> 62) {
+        /* the sum might not fit */
+        acc_add (s ? acc->n : acc->p, e + ACC_UNIT, t, 3);
+        memset (t, 0, 3 * sizeof (uint64_t));
+    }
+
+    sum = (uint128_t) t[0] + lo;
+    t[0] = MASK64(sum);
+    sum = (sum >> 64) + t[1] + hi;
+    t[1] = MASK64(sum);
+    t[2] += (uint64_t)(sum >> 64);
+}
+
+void deci_accumulate (deci_accumulator *acc, deci a) {
+    if (deci_is_zero (a)) return;
+    acc_add_128 (acc, a.s, a.e, M_LO(a), M_HI(a));
+}
+
+void deci_accumulate_n (deci_accumulator *acc, const deci a[], size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) deci_accumulate (acc, a[i]);
+}
+
+/* Adds the exact product a * b */
+void deci_accumulate_product (deci_accumulator *acc, deci a, deci b) {
+    uint64_t sa[] = {M_LO(a), M_HI(a)}, sb[] = {M_LO(b), M_HI(b)}, p[4];
+    uint128_t q;
+    bool s = (a.s != b.s);
+    int32_t e = a.e + b.e;
+
+    if (deci_is_zero (a) || deci_is_zero (b)) return;
+
+    if ((a.m2 == 0) && (b.m2 == 0)) {
+        q = (uint128_t) sa[0] * sb[0];
+        acc_add_128 (acc, s, e, MASK64(q), (uint64_t)(q >> 64));
+        return;
+    }
+
+    /* wider products go to the fixed-point sums directly */
+    if (e < acc->e) acc->e = e;
+    m_multiply (p, 2, sa, 2, sb);
+    acc_add (s ? acc->n : acc->p, e + ACC_UNIT, p, 4);
+}
+
+/* Rounds the sum of the products a[i] * b[i] once */
+deci deci_dot_n (const deci a[], const deci b[], size_t n) {
+    deci_accumulator acc;
+    size_t i;
+    deci_accumulator_init (&acc);
+    for (i = 0; i < n; i++) deci_accumulate_product (&acc, a[i], b[i]);
+    return deci_accumulator_result (&acc);
+}
+
+/*
+    Rounds the accumulated sum to deci, half even;
+    exact sums get the smallest exponent of the terms when they fit, like
+    deci_add results;
+    the accumulator is not modified;
+*/
+deci deci_accumulator_result (const deci_accumulator *acc) {
+    deci_accumulator f = *acc;
+    deci c;
+    uint64_t l[DECI_ACC_LIMBS + 2], v[4], x, half;
+    const uint64_t *big = f.p, *small = f.n;
+    int32_t i, t, cut, q, r, tb, borrow = 0;
+    bool sticky = false;
+
+    acc_flush (&f);
+
+    /* l = |p - n| */
+    for (i = DECI_ACC_LIMBS - 1; (i >= 0) && (f.p[i] == f.n[i]); i--) NOOP;
+    if (i < 0) return deci_zero;
+    c.s = f.p[i] < f.n[i];
+    if (c.s) {
+        big = f.n;
+        small = f.p;
+    }
+    for (i = 0; i < DECI_ACC_LIMBS; i++) {
+        if (big[i] >= small[i] + borrow) {
+            l[i] = big[i] - small[i] - borrow;
+            borrow = 0;
+        } else {
+            l[i] = E19 - (small[i] + borrow - big[i]);
+            borrow = 1;
+        }
+    }
+    l[DECI_ACC_LIMBS] = l[DECI_ACC_LIMBS + 1] = 0;
+
+    /*
+        cut the digits exceeding 26, but not above the lowest digit of the
+        terms unless the exponent would exceed 127, nor below exponent -128
+    */
+    for (t = DECI_ACC_LIMBS - 1; l[t] == 0; t--) NOOP;
+    for (i = 1; (i < 19) && (l[t] >= P[i][0]); i++) NOOP;
+    cut = f.e + ACC_UNIT < ACC_UNIT + 127 ? f.e + ACC_UNIT : ACC_UNIT + 127;
+    if (cut < 19 * t + i - 26) cut = 19 * t + i - 26;
+    if (cut < ACC_UNIT - 128) cut = ACC_UNIT - 128;
+    if (cut > ACC_UNIT + 127) OVERFLOW_ERROR;
+    q = cut / 19;
+    r = cut % 19;
+
+    /* v = limbs q to q + 2 in radix 2 ** 64 */
+    v[0] = l[q + 2];
+    m_multiply_1 (1, v, v, E19);
+    m_add_1 (v, l[q + 1]);
+    m_multiply_1 (2, v, v, E19);
+    m_add_1 (v, l[q]);
+
+    /* the truncate flag of the cut digits */
+    for (i = 0; i < q - (r == 0); i++) sticky |= (l[i] != 0);
+    if (r > 0) {
+        x = m_divide_pow10 (3, v, v, r);
+        half = 5 * P[r - 1][0];
+    } else if (q > 0) {
+        x = l[q - 1];
+        half = 5 * P[18][0];
+    } else {
+        x = 0;
+        half = 1;
+    }
+    if (x == 0) tb = sticky ? 1 : 0;
+    else if (x < half) tb = 1;
+    else if (x == half) tb = sticky ? 3 : 2;
+    else tb = 3;
+
+    /* round */
+    if ((tb == 3) || ((tb == 2) && (v[0] % 2 == 1))) {
+        m_add_1 (v, 1);
+        if (m_cmp (2, v, P26) == 0) {
+            v[0] = P[25][0];
+            v[1] = P[25][1];
+            if (++cut > ACC_UNIT + 127) OVERFLOW_ERROR;
+        }
+    }
+
+    m_to_deci (&c, v);
+    c.e = cut - ACC_UNIT;
+    return c;
+}
+
+/* l += t, both radix 10 ** 19 fixed-point sums */
+INLINE void acc_add_limbs (uint64_t l[], const uint64_t t[]) {
+    uint64_t s;
+    int32_t i, c = 0;
+    for (i = 0; i < DECI_ACC_LIMBS; i++) {
+        s = t[i] + c;  /* at most 10 ** 19 */
+        if (l[i] >= E19 - s) {
+            l[i] -= E19 - s;
+            c = 1;
+        } else {
+            l[i] += s;
+            c = 0;
+        }
+    }
+    if (c) OVERFLOW_ERROR;
+}
+
+/*
+    Adds the terms of accumulator b to acc;
+    the sums are exact, so merging the accumulators of the parts of a
+    sequence gives the same result however it was split;
+*/
+void deci_accumulator_merge (deci_accumulator *acc, const deci_accumulator *b) {
+    deci_accumulator f = *b;
+
+    acc_flush (&f);
+    acc_add_limbs (acc->p, f.p);
+    acc_add_limbs (acc->n, f.n);
+    if (f.e < acc->e) acc->e = f.e;
+}
+
+/*
+    Totals: the exact sum, minimum, maximum and count of a sequence;
+    of equal values (like 1 and 1.00) the first one is the minimum or
+    maximum, so the totals of consecutive parts merged in order are those
+    of the whole sequence;
+*/
+
+void deci_totals_init (deci_totals *t) {
+    deci_accumulator_init (&t->sum);
+    t->min = t->max = deci_zero;
+    t->n = t->nonzero = 0;
+}
+
+/* Adds values i to i + n - 1 of the columns */
+void deci_totals_columns (deci_totals *t, const deci_columns *v, size_t i, size_t n) {
+    deci a;
+    size_t end = i + n;
+
+    if ((n > 0) && (t->n == 0)) t->min = t->max = column_get (v, i);
+    t->n += n;
+    for (; i < end; i++) {
+        a = column_get (v, i);
+        if (!deci_is_zero (a)) {
+            t->nonzero++;
+            acc_add_128 (&t->sum, a.s, a.e, M_LO(a), M_HI(a));
+        }
+        if (deci_compare (a, t->min) < 0) t->min = a;
+        else if (deci_compare (a, t->max) > 0) t->max = a;
+    }
+}
+
+/* Adds totals u of the values following those of t */
+void deci_totals_merge (deci_totals *t, const deci_totals *u) {
+    if (u->n == 0) return;
+    deci_accumulator_merge (&t->sum, &u->sum);
+    if (t->n == 0) {
+        t->min = u->min;
+        t->max = u->max;
+    } else {
+        if (deci_compare (u->min, t->min) < 0) t->min = u->min;
+        if (deci_compare (u->max, t->max) > 0) t->max = u->max;
+    }
+    t->n += u->n;
+    t->nonzero += u->nonzero;
+}
@@ -36,6 +36,10 @@
 // See remarks in README.md for more information.
 //
 
+#ifdef DECI_STANDALONE
+    #include "deci-standalone.h"  /* instead of sys-core.h */
+#endif
+
 typedef struct {
     unsigned m0:32;  /* significand, lowest part */
     unsigned m1:32;  /* significand, continuation */
@@ -44,6 +48,55 @@ typedef struct {
     int e:8;         /* exponent */
 } deci;
 
+/* divisor prepared for repeated division, see deci_prepare_divisor() */
+typedef struct {
+    uint64_t b[3];   /* significand, 64-bit limbs, zero padded */
+    uint64_t d[2];   /* significand shifted to have the highest bit set */
+    uint64_t v;      /* reciprocal of d */
+    double l10;      /* decimal logarithm of the significand */
+    int32_t n;       /* number of nonzero limbs of b */
+    int32_t shift;   /* bit shift from b to d */
+    int32_t e;       /* exponent */
+    bool s;          /* sign */
+} deci_divisor;
+
+/* packed columns of decis, see deci_columns_at() */
+typedef struct {
+    uint64_t *lo;    /* significands, low 64 bits */
+    uint32_t *hi;    /* significands, high 23 bits */
+    int8_t *e;       /* exponents */
+    Byte *s;         /* signs */
+} deci_columns;
+
+/* item of the scratch space of deci_sort_n() */
+typedef struct {
+    Byte key[12];    /* see deci_to_key() */
+    deci d;
+} deci_sort_item;
+
+/* exact sum of decis and their products, see deci_accumulate() */
+#define DECI_ACC_LIMBS 32
+typedef struct {
+    uint64_t p[DECI_ACC_LIMBS];  /* positive terms, radix 10^19 limbs of 10^-256 */
+    uint64_t n[DECI_ACC_LIMBS];  /* magnitudes of the negative terms */
+    uint64_t pending[2][3];      /* binary sums not yet in p and n, by sign */
+    int32_t pending_e;           /* exponent of the pending sums */
+    int32_t e;                   /* smallest exponent of the nonzero terms */
+} deci_accumulator;
+
+/* exact sum, minimum, maximum and counts of a sequence, see deci_totals_init() */
+typedef struct {
+    deci_accumulator sum;
+    deci min, max;               /* the first of equal values, if n > 0 */
+    size_t n;                    /* values */
+    size_t nonzero;              /* nonzero values */
+} deci_totals;
+
+/* status flags of the checked operations, see deci_add_checked() */
+#define DECI_OVERFLOW        1
+#define DECI_DIVIDE_BY_ZERO  2
+#define DECI_INEXACT         4
+#define DECI_UNDERFLOW       8
 
 /* unary operators - logic */
 bool deci_is_zero (const deci a);
@@ -57,6 +110,15 @@ bool deci_is_equal (deci a, deci b);
 bool deci_is_lesser_or_equal (deci a, deci b);
 bool deci_is_same (deci a, deci b);
 
+/* three-way comparison, -1, 0 or 1 */
+int32_t deci_compare (deci a, deci b);
+int32_t deci_compare_int (deci a, int64_t b);
+int32_t deci_compare_decimal (deci a, double b);
+
+/* the same for all equal decis */
+deci deci_canonical (deci a);
+uint32_t deci_hash (deci a);
+
 /* binary operators - deci */
 deci deci_add (deci a, deci b);
 deci deci_subtract (deci a, deci b);
@@ -64,11 +126,79 @@ deci deci_multiply (const deci a, const deci b);
 deci deci_divide (deci a, deci b);
 deci deci_mod (deci a, deci b);
 
+/* the same as with int_to_deci (b), without the full significand kernels */
+deci deci_multiply_int (deci a, int64_t b);
+deci deci_divide_int (deci a, int64_t b);
+
+/* a * b + c, rounded once */
+deci deci_fma (deci a, deci b, deci c);
+
+/* repeated division by the same divisor */
+void deci_prepare_divisor (deci_divisor *p, deci b);
+deci deci_divide_prepared (deci a, const deci_divisor *p);
+
+/* array operations, c[i] = a[i] op b[i]; c may be a or b */
+void deci_add_n (deci c[], const deci a[], const deci b[], size_t n);
+void deci_subtract_n (deci c[], const deci a[], const deci b[], size_t n);
+void deci_multiply_n (deci c[], const deci a[], const deci b[], size_t n);
+void deci_divide_n (deci c[], const deci a[], const deci b[], size_t n);
+
+/* array operations with a scalar, c[i] = a[i] op b */
+void deci_add_scalar_n (deci c[], const deci a[], deci b, size_t n);
+void deci_subtract_scalar_n (deci c[], const deci a[], deci b, size_t n);
+void deci_multiply_scalar_n (deci c[], const deci a[], deci b, size_t n);
+void deci_divide_scalar_n (deci c[], const deci a[], deci b, size_t n);
+
+/* summing without intermediate rounding */
+void deci_accumulator_init (deci_accumulator *acc);
+void deci_accumulate (deci_accumulator *acc, deci a);
+void deci_accumulate_n (deci_accumulator *acc, const deci a[], size_t n);
+void deci_accumulate_product (deci_accumulator *acc, deci a, deci b);
+deci deci_accumulator_result (const deci_accumulator *acc);
+void deci_accumulator_merge (deci_accumulator *acc, const deci_accumulator *b);
+
+/* totals that merge exactly, for splitting a reduction over threads */
+void deci_totals_init (deci_totals *t);
+void deci_totals_columns (deci_totals *t, const deci_columns *v, size_t i, size_t n);
+void deci_totals_merge (deci_totals *t, const deci_totals *u);
+
+/* sum of the products a[i] * b[i], rounded once */
+deci deci_dot_n (const deci a[], const deci b[], size_t n);
+
+/* checked operations, returning status flags instead of panicking */
+uint32_t deci_add_checked (deci *c, deci a, deci b);
+uint32_t deci_subtract_checked (deci *c, deci a, deci b);
+uint32_t deci_multiply_checked (deci *c, deci a, deci b);
+uint32_t deci_divide_checked (deci *c, deci a, deci b);
+uint32_t deci_fma_checked (deci *r, deci a, deci b, deci c);
+uint32_t deci_add_n_checked (deci c[], const deci a[], const deci b[], size_t n);
+uint32_t deci_subtract_n_checked (deci c[], const deci a[], const deci b[], size_t n);
+uint32_t deci_multiply_n_checked (deci c[], const deci a[], const deci b[], size_t n);
+uint32_t deci_divide_n_checked (deci c[], const deci a[], const deci b[], size_t n);
+uint32_t deci_add_scalar_n_checked (deci c[], const deci a[], deci b, size_t n);
+uint32_t deci_subtract_scalar_n_checked (deci c[], const deci a[], deci b, size_t n);
+uint32_t deci_multiply_scalar_n_checked (deci c[], const deci a[], deci b, size_t n);
+uint32_t deci_divide_scalar_n_checked (deci c[], const deci a[], deci b, size_t n);
+
+/* packed columns */
+size_t deci_columns_size (size_t cap);
+void deci_columns_at (deci_columns *v, Byte *base, size_t cap);
+void deci_columns_move (Byte *base, size_t from_cap, size_t to_cap, size_t n);
+deci deci_columns_get (const deci_columns *v, size_t i);
+void deci_columns_put (const deci_columns *v, size_t i, deci a);
+void deci_columns_get_n (deci a[], const deci_columns *v, size_t i, size_t n);
+void deci_columns_put_n (const deci_columns *v, size_t i, const deci a[], size_t n);
+uint32_t deci_columns_add_n (const deci_columns *c, const deci_columns *a, const deci_columns *b, size_t n);
+uint32_t deci_columns_subtract_n (const deci_columns *c, const deci_columns *a, const deci_columns *b, size_t n);
+void deci_columns_compare_n (int8_t r[], const deci_columns *a, const deci_columns *b, size_t n);
+uint32_t deci_columns_ldexp_n (const deci_columns *c, const deci_columns *a, int32_t k, size_t n);
+
 /* conversion to deci */
 deci int_to_deci (int64_t a);
 deci decimal_to_deci (double a);
 deci string_to_deci (const Byte* s, const Byte* *endptr);
 deci binary_to_deci(const Byte s[12]);
+uint32_t binary_to_deci_checked (deci *c, const Byte s[12]);
 
 /* conversion to other datatypes */
 int64_t deci_to_int (const deci a);
@@ -76,6 +206,10 @@ double deci_to_decimal (const deci a);
 int32_t deci_to_string(Byte* string, const deci a, const Byte symbol, const Byte point);
 Byte* deci_to_binary(Byte binary[12], const deci a);
 
+/* keys whose memcmp order is the order of the values */
+Byte *deci_to_key (Byte key[12], const deci a);
+void deci_sort_n (deci a[], size_t n, deci_sort_item t[]);
+
 /* math functions */
 deci deci_ldexp (deci a, int32_t e);
 deci deci_truncate (deci a, deci b);
@@ -87,4 +221,17 @@ deci deci_half_away (deci a, deci b);
 deci deci_half_truncate (deci a, deci b);
 deci deci_half_ceil (deci a, deci b);
 deci deci_half_floor (deci a, deci b);
+
+/* rounding modes of deci_quantize() and deci_round() */
+#define DECI_ROUND_TRUNCATE       0
+#define DECI_ROUND_AWAY           1
+#define DECI_ROUND_FLOOR          2
+#define DECI_ROUND_CEIL           3
+#define DECI_ROUND_HALF_EVEN      4
+#define DECI_ROUND_HALF_AWAY      5
+#define DECI_ROUND_HALF_TRUNCATE  6
+#define DECI_ROUND_HALF_CEIL      7
+#define DECI_ROUND_HALF_FLOOR     8
+deci deci_quantize (deci a, int32_t e, int32_t mode);
+deci deci_round (deci a, deci b, int32_t mode);
 deci deci_sign (deci a);
@@ -0,0 +1,267 @@
+//
+//  file: %bench-deci.c
+//  summary: "Microbenchmarks of the deci operations, built on libdeci"
+//  project: "Rebol 3 Interpreter and Run-time"
+//  homepage: https://github.com/metaeducation/ren-c/
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Every operation runs over each input distribution: significands of 9
+// digits (cents-sized amounts) or of the full 26, with equal exponents or
+// exponents spread over 49 values.  The operations are timed in batches of
+// BATCH, and each case prints one JSON line:
+//
+//     {"op": "add", "dist": "wide-spread", "ns_per_op": 9.81,
+//         "p50_ns": 9.62, "p99_ns": 14.2, "ops": 3276800}
+//
+// where ns_per_op is the mean and the percentiles are those of the batches.
+//
+// Usage: bench-deci [-t milliseconds per case] [op or dist substring...]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "deci.h"
+
+#define VALUES 4096      /* inputs per case, a power of 2 */
+#define BATCH 64         /* operations per timing sample */
+#define MAX_SAMPLES 200000
+
+static volatile uint32_t sink;  /* keeps the results alive */
+
+/* xorshift64, the inputs are the same on every run */
+static uint64_t rnd_state = 88172645463325252u;
+static uint64_t rnd (void) {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state;
+}
+
+/* the input distributions */
+typedef struct {
+    const char *name;
+    int32_t digits;   /* at most this many significand digits */
+    int32_t spread;   /* exponents from -2 - spread to -2 + spread */
+} dist;
+
+static const dist DISTS[] = {
+    {"narrow-flat", 9, 0},
+    {"narrow-spread", 9, 24},
+    {"wide-flat", 26, 0},
+    {"wide-spread", 26, 24},
+};
+
+/* nonzero deci of distribution d */
+static deci make_input (const dist *d) {
+    deci a;
+    uint64_t lo, hi;
+
+    if (d->digits <= 19) {
+        lo = rnd () % 1000000000u;  /* 9 digits */
+        hi = 0;
+    } else {
+        /* below 1e26: hi:lo below 0x52B7D2DCC80CD2E4000000 */
+        hi = rnd () % 0x52B7D2u;
+        lo = rnd ();
+    }
+    if ((lo | hi) == 0) lo = 1;
+    a.m0 = (uint32_t) lo;
+    a.m1 = (uint32_t)(lo >> 32);
+    a.m2 = (uint32_t) hi;
+    a.s = rnd () & 1;
+    a.e = -2 + (d->spread ? (int32_t)(rnd () % (2 * d->spread + 1)) - d->spread : 0);
+    return a;
+}
+
+/* inputs of a case, and the conversions prepared from them */
+static deci A[VALUES], B[VALUES];
+static int64_t INTS[VALUES];  /* quantities, 1 to 1000 */
+static double DOUBLES[VALUES];
+static Byte STRINGS[VALUES][64];
+static Byte BINARIES[VALUES][12];
+static deci CENT;
+
+typedef uint32_t (*op_fn) (size_t i);
+
+#define DECI_OP(name, expr) \
+    static uint32_t name (size_t i) { deci c = (expr); return c.m0 ^ c.e; }
+
+DECI_OP(op_add, deci_add (A[i], B[i]))
+DECI_OP(op_subtract, deci_subtract (A[i], B[i]))
+DECI_OP(op_multiply, deci_multiply (A[i], B[i]))
+DECI_OP(op_divide, deci_divide (A[i], B[i]))
+DECI_OP(op_multiply_int, deci_multiply_int (A[i], INTS[i]))
+DECI_OP(op_divide_int, deci_divide_int (A[i], INTS[i]))
+DECI_OP(op_mod, deci_mod (A[i], B[i]))
+DECI_OP(op_truncate, deci_truncate (A[i], CENT))
+DECI_OP(op_away, deci_away (A[i], CENT))
+DECI_OP(op_floor, deci_floor (A[i], CENT))
+DECI_OP(op_ceil, deci_ceil (A[i], CENT))
+DECI_OP(op_half_even, deci_half_even (A[i], CENT))
+DECI_OP(op_half_away, deci_half_away (A[i], CENT))
+DECI_OP(op_half_truncate, deci_half_truncate (A[i], CENT))
+DECI_OP(op_half_ceil, deci_half_ceil (A[i], CENT))
+DECI_OP(op_half_floor, deci_half_floor (A[i], CENT))
+DECI_OP(op_quantize_half_even, deci_quantize (A[i], -2, DECI_ROUND_HALF_EVEN))
+DECI_OP(op_quantize_half_away, deci_quantize (A[i], -2, DECI_ROUND_HALF_AWAY))
+DECI_OP(op_from_double, decimal_to_deci (DOUBLES[i]))
+DECI_OP(op_from_binary, binary_to_deci (BINARIES[i]))
+
+static uint32_t op_to_string (size_t i) {
+    Byte s[64];
+    return (uint32_t) deci_to_string (s, A[i], 0, '.') ^ s[1];
+}
+
+static uint32_t op_from_string (size_t i) {
+    const Byte *end;
+    deci c = string_to_deci (STRINGS[i], &end);
+    return c.m0 ^ c.e ^ *end;
+}
+
+static uint32_t op_to_double (size_t i) {
+    double d = deci_to_decimal (A[i]);
+    uint32_t u;
+    memcpy (&u, &d, sizeof (u));
+    return u;
+}
+
+static uint32_t op_to_binary (size_t i) {
+    Byte s[12];
+    deci_to_binary (s, A[i]);
+    return s[11];
+}
+
+static const struct {
+    const char *name;
+    op_fn fn;
+} OPS[] = {
+    {"add", op_add},
+    {"subtract", op_subtract},
+    {"multiply", op_multiply},
+    {"divide", op_divide},
+    {"multiply-int", op_multiply_int},
+    {"divide-int", op_divide_int},
+    {"mod", op_mod},
+    {"round-truncate", op_truncate},
+    {"round-away", op_away},
+    {"round-floor", op_floor},
+    {"round-ceil", op_ceil},
+    {"round-half-even", op_half_even},
+    {"round-half-away", op_half_away},
+    {"round-half-truncate", op_half_truncate},
+    {"round-half-ceil", op_half_ceil},
+    {"round-half-floor", op_half_floor},
+    {"quantize-half-even", op_quantize_half_even},
+    {"quantize-half-away", op_quantize_half_away},
+    {"to-string", op_to_string},
+    {"from-string", op_from_string},
+    {"to-double", op_to_double},
+    {"from-double", op_from_double},
+    {"to-binary", op_to_binary},
+    {"from-binary", op_from_binary},
+};
+
+static double now_ns (void) {
+    struct timespec t;
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static int compare_doubles (const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static void prepare_inputs (const dist *d) {
+    size_t i;
+    int32_t n;
+
+    for (i = 0; i < VALUES; i++) {
+        A[i] = make_input (d);
+        B[i] = make_input (d);
+        INTS[i] = (int64_t)(rnd () % 1000) + 1;
+        DOUBLES[i] = deci_to_decimal (A[i]);
+        n = deci_to_string (STRINGS[i], A[i], 0, '.');
+        STRINGS[i][n] = '\0';
+        deci_to_binary (BINARIES[i], A[i]);
+    }
+}
+
+/* times fn over the inputs for about ms milliseconds, prints the JSON line */
+static void run_case (const char *op, op_fn fn, const char *dist_name, double ms) {
+    static double samples[MAX_SAMPLES];
+    double start, t, total = 0;
+    size_t n = 0, i = 0, j;
+    uint32_t x = 0;
+
+    for (j = 0; j < VALUES; j++) x ^= fn (j);  /* warm up */
+
+    start = now_ns ();
+    while ((n < MAX_SAMPLES) && (now_ns () - start < ms * 1e6)) {
+        t = now_ns ();
+        for (j = 0; j < BATCH; j++) x ^= fn ((i + j) & (VALUES - 1));
+        samples[n] = (now_ns () - t) / BATCH;
+        total += samples[n++];
+        i += BATCH;
+    }
+    sink ^= x;
+
+    qsort (samples, n, sizeof (double), compare_doubles);
+    printf (
+        "{\"op\": \"%s\", \"dist\": \"%s\", \"ns_per_op\": %.2f,"
+        " \"p50_ns\": %.2f, \"p99_ns\": %.2f, \"ops\": %zu}\n",
+        op, dist_name, total / n, samples[n / 2], samples[n * 99 / 100], n * BATCH
+    );
+    fflush (stdout);
+}
+
+/* a case runs if no filters are given or its op or dist contains one */
+static bool selected (const char *op, const char *dist_name, int argc, char **argv) {
+    int k;
+    bool any = false;
+    for (k = 1; k < argc; k++) {
+        if (argv[k][0] == '-') {
+            k++;  /* option and its value */
+            continue;
+        }
+        any = true;
+        if (strstr (op, argv[k]) || strstr (dist_name, argv[k])) return true;
+    }
+    return !any;
+}
+
+int main (int argc, char **argv) {
+    double ms = 200;
+    size_t d, o;
+    int k;
+
+    for (k = 1; k < argc - 1; k++)
+        if (strcmp (argv[k], "-t") == 0) ms = atof (argv[k + 1]);
+
+    CENT = decimal_to_deci (0.01);
+
+    for (d = 0; d < sizeof (DISTS) / sizeof (DISTS[0]); d++) {
+        prepare_inputs (&DISTS[d]);
+        for (o = 0; o < sizeof (OPS) / sizeof (OPS[0]); o++)
+            if (selected (OPS[o].name, DISTS[d].name, argc, argv))
+                run_case (OPS[o].name, OPS[o].fn, DISTS[d].name, ms);
+    }
+    return 0;
+}
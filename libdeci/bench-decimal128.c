@@ -0,0 +1,424 @@
+//
+//  file: %bench-decimal128.c
+//  summary: "The same money workloads through deci and GCC's _Decimal128"
+//  project: "Rebol 3 Interpreter and Run-time"
+//  homepage: https://github.com/metaeducation/ren-c/
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// The workloads run on the same values through libdeci and through GCC's
+// built-in _Decimal128 (the BID encoding, implemented by libgcc):
+//
+//     sum          running total of the amounts
+//     price-qty    amount times an integer quantity from 1 to 1000
+//     divide-rate  amount divided by a 5-digit rate from 0.5 to 2
+//     round-cents  amount rounded half even to 0.01
+//     parse        string to number
+//     format       number to string
+//
+// The amounts come in the distributions of %bench-deci.c.  Each case prints
+// one JSON line:
+//
+//     {"impl": "decimal128", "op": "price-qty", "dist": "wide-flat",
+//         "ns_per_op": 31.2, "p99_ns": 35.0, "latency_ns": 40.1, "mops": 32.1}
+//
+// ns_per_op and mops are the throughput over independent operations, and
+// p99_ns the 99th percentile of its timed batches; latency_ns is the time
+// per operation when each one picks its input by the result of the previous
+// one, so they cannot overlap.
+//
+// The C library has no _Decimal128 string conversions or quantize, so the
+// parse, format and round-cents workloads use the helpers below that work on
+// the BID128 fields directly, the way deci's own conversions work on its.
+// They are checked to give the same values and strings as deci first.
+//
+// Usage: bench-decimal128 [-t milliseconds per case] [substring...]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "deci.h"
+
+#define VALUES 4096      /* inputs per case, a power of 2 */
+#define BATCH 64         /* operations per timing sample */
+#define MAX_SAMPLES 200000
+
+typedef _Decimal128 d128;
+typedef unsigned __int128 u128;
+
+static volatile uint32_t sink;  /* keeps the results alive */
+
+/* xorshift64, the inputs are the same on every run */
+static uint64_t rnd_state = 88172645463325252u;
+static uint64_t rnd (void) {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state;
+}
+
+/* the input distributions, as in bench-deci.c */
+typedef struct {
+    const char *name;
+    int32_t digits;   /* at most this many significand digits */
+    int32_t spread;   /* exponents from -2 - spread to -2 + spread */
+} dist;
+
+static const dist DISTS[] = {
+    {"narrow-flat", 9, 0},
+    {"narrow-spread", 9, 24},
+    {"wide-flat", 26, 0},
+    {"wide-spread", 26, 24},
+};
+
+static deci make_input (const dist *d) {
+    deci a;
+    uint64_t lo, hi;
+
+    if (d->digits <= 19) {
+        lo = rnd () % 1000000000u;
+        hi = 0;
+    } else {
+        hi = rnd () % 0x52B7D2u;  /* below 1e26 */
+        lo = rnd ();
+    }
+    if ((lo | hi) == 0) lo = 1;
+    a.m0 = (uint32_t) lo;
+    a.m1 = (uint32_t)(lo >> 32);
+    a.m2 = (uint32_t) hi;
+    a.s = rnd () & 1;
+    a.e = -2 + (d->spread ? (int32_t)(rnd () % (2 * d->spread + 1)) - d->spread : 0);
+    return a;
+}
+
+/*
+    BID128 fields: sign bit 127, biased exponent in bits 113 to 126 and the
+    coefficient below, for the finite values with coefficients below 2 ** 113
+    (all the canonical ones);
+*/
+
+#define BID_BIAS 6176
+
+static d128 d128_from_parts (bool s, u128 coefficient, int32_t e) {
+    u128 bits = coefficient | (u128)(e + BID_BIAS) << 113 | (u128) s << 127;
+    d128 d;
+    memcpy (&d, &bits, sizeof (d));
+    return d;
+}
+
+static u128 d128_to_parts (d128 d, bool *s, int32_t *e) {
+    u128 bits;
+    memcpy (&bits, &d, sizeof (bits));
+    *s = (bool)(bits >> 127);
+    *e = (int32_t)((bits >> 113) & 0x3FFF) - BID_BIAS;
+    return bits & (((u128) 1 << 113) - 1);
+}
+
+static d128 deci_to_d128 (deci a) {
+    u128 c = (u128) a.m2 << 64 | (u128) a.m1 << 32 | a.m0;
+    return d128_from_parts (a.s, c, a.e);
+}
+
+/* half even to 0.01, the coefficient of a result with exponent -2 */
+static d128 d128_round_cents (d128 d) {
+    bool s;
+    int32_t e;
+    u128 c = d128_to_parts (d, &s, &e), q, r, p = 1;
+
+    if (e >= -2) return d;  /* a multiple of 0.01 already */
+    for (; e < -2; e++) p *= 10;
+    q = c / p;
+    r = c % p;
+    if ((2 * r > p) || ((2 * r == p) && (q & 1))) q++;
+    return d128_from_parts (s, q, -2);
+}
+
+/* parses [-]digits[.digits][e[-]digits], up to 34 digits */
+static d128 d128_parse (const Byte *s, const Byte **end) {
+    bool neg = false, eneg = false;
+    u128 c = 0;
+    int32_t e = 0, x = 0;
+
+    if (*s == '-') {
+        neg = true;
+        s++;
+    }
+    for (; (*s >= '0') && (*s <= '9'); s++) c = c * 10 + (*s - '0');
+    if (*s == '.')
+        for (s++; (*s >= '0') && (*s <= '9'); s++, e--) c = c * 10 + (*s - '0');
+    if ((*s == 'e') || (*s == 'E')) {
+        s++;
+        if (*s == '-') {
+            eneg = true;
+            s++;
+        }
+        for (; (*s >= '0') && (*s <= '9'); s++) x = x * 10 + (*s - '0');
+        e += eneg ? -x : x;
+    }
+    *end = s;
+    return d128_from_parts (neg, c, e);
+}
+
+/* formats as deci_to_string does with no symbol and a '.' point */
+static int32_t d128_format (Byte *string, d128 d) {
+    Byte digits[40], *s = string;
+    bool neg;
+    int32_t x, j = 0, e, k, i;
+    u128 c = d128_to_parts (d, &neg, &x);
+    uint64_t lo, hi;
+
+    if (neg) *s++ = '-';
+    if (c == 0) {
+        *s++ = '0';
+        *s = '\0';
+        return (int32_t)(s - string);
+    }
+
+    /* reversed, 64-bit divisions for all but the 19-digit split */
+    lo = (uint64_t)(c % 10000000000000000000u);
+    hi = (uint64_t)(c / 10000000000000000000u);
+    for (; lo || (hi && (j < 19)); lo /= 10) digits[j++] = '0' + (Byte)(lo % 10);
+    for (; hi; hi /= 10) digits[j++] = '0' + (Byte)(hi % 10);
+    e = j + x;
+
+    if ((e <= 0) && (e >= -6)) {
+        *s++ = '0';
+        *s++ = '.';
+        for (i = 0; i < -e; i++) *s++ = '0';
+        for (i = j - 1; i >= 0; i--) *s++ = digits[i];
+    } else if ((e < -6) || ((e > 0) && (e < j))) {
+        k = e < 0 ? 1 : e;
+        for (i = j - 1; i >= 0; i--) {
+            *s++ = digits[i];
+            if ((j - i == k) && (i > 0)) *s++ = '.';
+        }
+        if (e < -6) s += sprintf ((char *) s, "e%d", (int)(e - 1));
+    } else {
+        for (i = j - 1; i >= 0; i--) *s++ = digits[i];
+        if (j < e) s += sprintf ((char *) s, "e%d", (int)(e - j));
+    }
+
+    *s = '\0';
+    return (int32_t)(s - string);
+}
+
+/* the inputs of a distribution in both representations */
+static deci A[VALUES], QTY[VALUES], RATE[VALUES], CENT, TOTAL;
+static d128 DA[VALUES], DQTY[VALUES], DRATE[VALUES], DTOTAL;
+static Byte STRINGS[VALUES][64];
+
+static void prepare_inputs (const dist *d) {
+    size_t i;
+    int32_t n;
+
+    for (i = 0; i < VALUES; i++) {
+        A[i] = make_input (d);
+        QTY[i] = int_to_deci ((int64_t)(rnd () % 1000) + 1);
+        RATE[i] = deci_ldexp (int_to_deci ((int64_t)(rnd () % 15000) + 5000), -4);
+        DA[i] = deci_to_d128 (A[i]);
+        DQTY[i] = deci_to_d128 (QTY[i]);
+        DRATE[i] = deci_to_d128 (RATE[i]);
+        n = deci_to_string (STRINGS[i], A[i], 0, '.');
+        STRINGS[i][n] = '\0';
+    }
+    TOTAL = int_to_deci (0);
+    DTOTAL = 0;
+}
+
+typedef uint32_t (*op_fn) (size_t i);
+
+static uint32_t deci_bits (deci c) {
+    return c.m0 ^ c.e;
+}
+
+static uint32_t d128_bits (d128 d) {
+    uint32_t u;
+    memcpy (&u, &d, sizeof (u));
+    return u;
+}
+
+static uint32_t deci_sum (size_t i) {
+    TOTAL = deci_add (TOTAL, A[i]);
+    return deci_bits (TOTAL);
+}
+
+static uint32_t d128_sum (size_t i) {
+    DTOTAL += DA[i];
+    return d128_bits (DTOTAL);
+}
+
+static uint32_t deci_price_qty (size_t i) {
+    return deci_bits (deci_multiply (A[i], QTY[i]));
+}
+
+static uint32_t d128_price_qty (size_t i) {
+    return d128_bits (DA[i] * DQTY[i]);
+}
+
+static uint32_t deci_divide_rate (size_t i) {
+    return deci_bits (deci_divide (A[i], RATE[i]));
+}
+
+static uint32_t d128_divide_rate (size_t i) {
+    return d128_bits (DA[i] / DRATE[i]);
+}
+
+static uint32_t deci_round_cents (size_t i) {
+    return deci_bits (deci_quantize (A[i], -2, DECI_ROUND_HALF_EVEN));
+}
+
+static uint32_t d128_round_cents_op (size_t i) {
+    return d128_bits (d128_round_cents (DA[i]));
+}
+
+static uint32_t deci_parse (size_t i) {
+    const Byte *end;
+    return deci_bits (string_to_deci (STRINGS[i], &end)) ^ *end;
+}
+
+static uint32_t d128_parse_op (size_t i) {
+    const Byte *end;
+    return d128_bits (d128_parse (STRINGS[i], &end)) ^ *end;
+}
+
+static uint32_t deci_format (size_t i) {
+    Byte s[64];
+    return (uint32_t) deci_to_string (s, A[i], 0, '.') ^ s[1];
+}
+
+static uint32_t d128_format_op (size_t i) {
+    Byte s[64];
+    return (uint32_t) d128_format (s, DA[i]) ^ s[1];
+}
+
+static const struct {
+    const char *name;
+    op_fn deci_fn;
+    op_fn d128_fn;
+} OPS[] = {
+    {"sum", deci_sum, d128_sum},
+    {"price-qty", deci_price_qty, d128_price_qty},
+    {"divide-rate", deci_divide_rate, d128_divide_rate},
+    {"round-cents", deci_round_cents, d128_round_cents_op},
+    {"parse", deci_parse, d128_parse_op},
+    {"format", deci_format, d128_format_op},
+};
+
+static double now_ns (void) {
+    struct timespec t;
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static int compare_doubles (const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* times fn both ways for about ms milliseconds each, prints the JSON line */
+static void run_case (const char *impl, const char *op, op_fn fn, const char *dist_name, double ms) {
+    static double samples[MAX_SAMPLES];
+    double start, t, total = 0, latency;
+    size_t n = 0, i = 0, j, chained = 0;
+    uint32_t x = 0;
+
+    for (j = 0; j < VALUES; j++) x ^= fn (j);  /* warm up */
+
+    start = now_ns ();
+    while ((n < MAX_SAMPLES) && (now_ns () - start < ms * 1e6)) {
+        t = now_ns ();
+        for (j = 0; j < BATCH; j++) x ^= fn ((i + j) & (VALUES - 1));
+        samples[n] = (now_ns () - t) / BATCH;
+        total += samples[n++];
+        i += BATCH;
+    }
+
+    /* the next index depends on the last result */
+    start = now_ns ();
+    for (i = 0; now_ns () - start < ms * 1e6; chained += BATCH)
+        for (j = 0; j < BATCH; j++) i = (i + 1 + (fn (i) & 1)) & (VALUES - 1);
+    latency = (now_ns () - start) / chained;
+    sink ^= x ^ (uint32_t) i;
+
+    qsort (samples, n, sizeof (double), compare_doubles);
+    printf (
+        "{\"impl\": \"%s\", \"op\": \"%s\", \"dist\": \"%s\", \"ns_per_op\": %.2f,"
+        " \"p99_ns\": %.2f, \"latency_ns\": %.2f, \"mops\": %.2f}\n",
+        impl, op, dist_name, total / n, samples[n * 99 / 100], latency, 1e3 * n / total
+    );
+    fflush (stdout);
+}
+
+/* a case runs if no filters are given or its op or dist contains one */
+static bool selected (const char *op, const char *dist_name, int argc, char **argv) {
+    int k;
+    bool any = false;
+    for (k = 1; k < argc; k++) {
+        if (argv[k][0] == '-') {
+            k++;  /* option and its value */
+            continue;
+        }
+        any = true;
+        if (strstr (op, argv[k]) || strstr (dist_name, argv[k])) return true;
+    }
+    return !any;
+}
+
+/* the helpers must give the values deci does before they are timed */
+static bool check_helpers (void) {
+    Byte s[64];
+    const Byte *end;
+    size_t i;
+    int32_t n;
+
+    for (i = 0; i < VALUES; i++) {
+        if (d128_parse (STRINGS[i], &end) != DA[i]) return false;
+        n = d128_format (s, DA[i]);
+        s[n] = '\0';
+        if (strcmp ((char *) s, (char *) STRINGS[i]) != 0) return false;
+        if (d128_round_cents (DA[i]) != deci_to_d128 (deci_half_even (A[i], CENT)))
+            return false;
+    }
+    return true;
+}
+
+int main (int argc, char **argv) {
+    double ms = 200;
+    size_t d, o;
+    int k;
+
+    for (k = 1; k < argc - 1; k++)
+        if (strcmp (argv[k], "-t") == 0) ms = atof (argv[k + 1]);
+
+    CENT = decimal_to_deci (0.01);
+
+    for (d = 0; d < sizeof (DISTS) / sizeof (DISTS[0]); d++) {
+        prepare_inputs (&DISTS[d]);
+        if (!check_helpers ()) {
+            fprintf (stderr, "_Decimal128 helpers disagree with deci on %s\n", DISTS[d].name);
+            return 1;
+        }
+        for (o = 0; o < sizeof (OPS) / sizeof (OPS[0]); o++) {
+            if (!selected (OPS[o].name, DISTS[d].name, argc, argv)) continue;
+            run_case ("deci", OPS[o].name, OPS[o].deci_fn, DISTS[d].name, ms);
+            run_case ("decimal128", OPS[o].name, OPS[o].d128_fn, DISTS[d].name, ms);
+        }
+    }
+    return 0;
+}
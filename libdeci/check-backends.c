@@ -0,0 +1,279 @@
+//
+//  file: %check-backends.c
+//  summary: "Fingerprints of the deci results, for comparing the backends"
+//  project: "Rebol 3 Interpreter and Run-time"
+//  homepage: https://github.com/metaeducation/ren-c/
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Runs the operations built on the add, multiply and divide kernels over the
+// same pseudo-random inputs, and prints one line per operation with a hash
+// of all the result bits, status flags and errors:
+//
+//     add 1000000 9f1c04a2b1e6d35c
+//
+// `make test` builds this with both backends (see note [J] of %deci.c) and
+// fails if the outputs differ.  The inputs lean on the hard cases: full
+// 26-digit significands, values just below 10^26, trailing fives that make
+// rounding ties, and exponents at both ends of the range.  Some pairs are
+// built so that the exact product or quotient lies a few units away from a
+// 26-digit tie or carry, where the _Decimal128 kernels have to correct
+// their 34-digit rounding by the sign of the residual.
+//
+// Usage: check-backends [-n cases]
+//
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "deci.h"
+
+/* xorshift64, the inputs are the same on every run */
+static uint64_t rnd_state = 88172645463325252u;
+static uint64_t rnd (void) {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state;
+}
+
+typedef unsigned __int128 uint128_t;
+
+static uint128_t P10[39];  /* up to 10^38, the largest in 128 bits */
+
+static deci make_input (void) {
+    deci a;
+    uint128_t m;
+    int32_t d = (int32_t)(rnd () % 27);
+
+    m = ((uint128_t) rnd () << 64 | rnd ()) % P10[d ? d : 1];
+    if (rnd () % 6 == 0)  /* ends in 5 or 0 after some zeros, ties */
+        m = m / P10[rnd () % 4] * P10[rnd () % 4] + 5 * (rnd () % 2);
+    if (rnd () % 7 == 0)  /* just below 10^26 */
+        m = P10[26] - 1 - rnd () % 3;
+    if (rnd () % 10 == 0)
+        m = 0;
+    m %= P10[26];
+
+    a.m0 = (uint32_t) m;
+    a.m1 = (uint32_t)(m >> 32);
+    a.m2 = (uint32_t)(m >> 64);
+    a.s = rnd () & 1;
+    a.e = rnd () % 3 == 0 ? (int32_t)(rnd () % 256) - 128 : (int32_t)(rnd () % 40) - 20;
+    return a;
+}
+
+static deci make_deci (uint128_t m) {
+    deci a;
+
+    a.m0 = (uint32_t) m;
+    a.m1 = (uint32_t)(m >> 32);
+    a.m2 = (uint32_t)(m >> 64);
+    a.s = rnd () & 1;
+    a.e = (int32_t)(rnd () % 40) - 20;
+    return a;
+}
+
+/* a random significand of n digits, coprime to 10 */
+static uint128_t odd_significand (int32_t n) {
+    uint128_t m = P10[n - 1] + ((uint128_t) rnd () << 64 | rnd ()) % (9 * P10[n - 1]);
+    m |= 1;
+    if (m % 5 == 0) m += 2;
+    return m;
+}
+
+/* the inverse of a modulo m, for a coprime to m < 2 ** 63 */
+static uint128_t inverse_mod (uint128_t a, uint128_t m) {
+    __int128 r0 = (__int128) m, r1 = (__int128)(a % m), t0 = 0, t1 = 1, q, x;
+
+    while (r1 != 0) {
+        q = r0 / r1;
+        x = r0 - q * r1; r0 = r1; r1 = x;
+        x = t0 - q * t1; t0 = t1; t1 = x;
+    }
+    return (uint128_t)(t0 < 0 ? t0 + (__int128) m : t0);
+}
+
+/* how far below or above the tie or carry of a unit u the result lands */
+static uint128_t near_boundary (uint128_t u) {
+    switch (rnd () % 4) {
+    case 0: return u / 2 - 1 - rnd () % 3;
+    case 1: return u / 2 + 1 + rnd () % 3;
+    case 2: return u - 1 - rnd () % 3;
+    default: return 1 + rnd () % 3;
+    }
+}
+
+/*
+    a * b of 26 + j digits with a * b mod 10^j near a tie or carry of the
+    26-digit result, the 34-digit rounding of the product crosses it;
+*/
+static bool make_hard_product (deci *a, deci *b) {
+    int32_t j = 9 + (int32_t)(rnd () % 4);
+    uint128_t u = P10[j], ma = odd_significand (26), mb;
+
+    mb = near_boundary (u) * inverse_mod (ma, u) % u;
+    if ((mb == 0) || (ma * mb < P10[25 + j])) return false;
+
+    *a = make_deci (ma);
+    *b = make_deci (mb);
+    return true;
+}
+
+/*
+    a * 10^s / b of 26 digits with a remainder near b / 2 or b, the
+    34-digit rounding of the quotient crosses a tie or carry;
+*/
+static bool make_hard_quotient (deci *a, deci *b) {
+    int32_t k = 9 + (int32_t)(rnd () % 4), s = k - (int32_t)(rnd () % 2);
+    uint128_t mb = odd_significand (k), ma, q;
+
+    ma = near_boundary (mb) % mb * inverse_mod (P10[s] % mb, mb) % mb;
+    ma += (P10[25] + ((uint128_t) rnd () << 64 | rnd ()) % (9 * P10[25])) / mb * mb;
+    if (ma >= P10[26]) return false;
+    q = ma * P10[s] / mb;
+    if ((q < P10[25]) || (q >= P10[26])) return false;
+
+    *a = make_deci (ma);
+    *b = make_deci (mb);
+    return true;
+}
+
+/* FNV-1a over everything an operation gives back */
+typedef struct {
+    const char *name;
+    uint64_t h;
+} fingerprint;
+
+static void mix (fingerprint *f, uint64_t x) {
+    int32_t i;
+    for (i = 0; i < 8; i++) {
+        f->h ^= (x >> (8 * i)) & 0xFF;
+        f->h *= 1099511628211u;
+    }
+}
+
+static void mix_deci (fingerprint *f, deci c, uint32_t status) {
+    mix (f, (uint64_t) c.m1 << 32 | c.m0);
+    mix (f, (uint64_t) c.m2 << 32 | (uint64_t)(uint8_t) c.e << 1 | c.s);
+    mix (f, status);
+}
+
+/* the unchecked operations report their errors here */
+static jmp_buf on_error;
+static void error_handler (uint32_t flag) {
+    longjmp (on_error, (int) flag);
+}
+
+#define UNCHECKED(f, expr) do { \
+    volatile deci c_ = deci_zero_value; \
+    int e_ = setjmp (on_error); \
+    if (e_ == 0) c_ = (expr); \
+    mix_deci ((f), c_, (uint32_t) e_); \
+} while (0)
+
+static const deci deci_zero_value = {0, 0, 0, 0, 0};
+
+enum {
+    ADD, SUBTRACT, MULTIPLY, DIVIDE, FMA,
+    DIVIDE_PREPARED, MULTIPLY_INT, DIVIDE_INT, MOD,
+    HALF_EVEN, HALF_AWAY, CEIL, QUANTIZE, ROUND,
+    ADD_N, DIVIDE_SCALAR_N, DOT,
+    OPS
+};
+
+static fingerprint F[OPS] = {
+    {"add", 0}, {"subtract", 0}, {"multiply", 0}, {"divide", 0}, {"fma", 0},
+    {"divide-prepared", 0}, {"multiply-int", 0}, {"divide-int", 0}, {"mod", 0},
+    {"round-half-even", 0}, {"round-half-away", 0}, {"round-ceil", 0},
+    {"quantize", 0}, {"round", 0},
+    {"add-n", 0}, {"divide-scalar-n", 0}, {"dot", 0},
+};
+
+#define BLOCK 16
+
+static deci as[BLOCK], bs[BLOCK], cs[BLOCK];
+
+/* the operations of case i, its inputs are drawn here */
+static void check_case (long i) {
+    deci a, b, c, r;
+    deci_divisor p;
+    int64_t q;
+    int32_t j;
+
+    a = make_input ();
+    b = make_input ();
+    c = make_input ();
+    switch (rnd () % 8) {
+    case 0: while (!make_hard_product (&a, &b)) NOOP; break;
+    case 1: while (!make_hard_quotient (&a, &b)) NOOP; break;
+    }
+    q = (int64_t)(rnd () % 4 == 0 ? rnd () >> 1 : rnd () % 2000) - (rnd () % 2 ? 1000 : 0);
+
+    mix_deci (&F[ADD], r, deci_add_checked (&r, a, b));
+    mix_deci (&F[SUBTRACT], r, deci_subtract_checked (&r, a, b));
+    mix_deci (&F[MULTIPLY], r, deci_multiply_checked (&r, a, b));
+    mix_deci (&F[DIVIDE], r, deci_divide_checked (&r, a, b));
+    mix_deci (&F[FMA], r, deci_fma_checked (&r, a, b, c));
+
+    if (!deci_is_zero (b)) {
+        deci_prepare_divisor (&p, b);
+        UNCHECKED (&F[DIVIDE_PREPARED], deci_divide_prepared (a, &p));
+    }
+
+    UNCHECKED (&F[MULTIPLY_INT], deci_multiply_int (a, q));
+    UNCHECKED (&F[DIVIDE_INT], deci_divide_int (a, q));
+    UNCHECKED (&F[MOD], deci_mod (a, b));
+
+    UNCHECKED (&F[HALF_EVEN], deci_half_even (a, b));
+    UNCHECKED (&F[HALF_AWAY], deci_half_away (a, b));
+    UNCHECKED (&F[CEIL], deci_ceil (a, b));
+    UNCHECKED (&F[QUANTIZE], deci_quantize (a, c.e, (int32_t)(rnd () % 9)));
+    UNCHECKED (&F[ROUND], deci_round (a, b, (int32_t)(rnd () % 9)));
+
+    as[i % BLOCK] = a;
+    bs[i % BLOCK] = b;
+    if (i % BLOCK == BLOCK - 1) {
+        mix (&F[ADD_N], deci_add_n_checked (cs, as, bs, BLOCK));
+        for (j = 0; j < BLOCK; j++) mix_deci (&F[ADD_N], cs[j], 0);
+        mix (&F[DIVIDE_SCALAR_N], deci_divide_scalar_n_checked (cs, as, c, BLOCK));
+        for (j = 0; j < BLOCK; j++) mix_deci (&F[DIVIDE_SCALAR_N], cs[j], 0);
+        UNCHECKED (&F[DOT], deci_dot_n (as, bs, BLOCK));
+    }
+}
+
+int main (int argc, char **argv) {
+    long n = 1000000, i;
+    int32_t j, k;
+
+    for (k = 1; k < argc - 1; k++)
+        if (strcmp (argv[k], "-n") == 0) n = atol (argv[k + 1]);
+
+    P10[0] = 1;
+    for (j = 1; j < 39; j++) P10[j] = P10[j - 1] * 10;
+    for (j = 0; j < OPS; j++) F[j].h = 14695981039346656037u;
+
+    deci_set_error_handler (&error_handler);
+
+    for (i = 0; i < n; i++) check_case (i);
+
+    for (j = 0; j < OPS; j++)
+        printf ("%s %ld %016llx\n", F[j].name, n, (unsigned long long) F[j].h);
+    return 0;
+}
@@ -2,7 +2,7 @@ Rebol [
     name: Deci
     notes: "See %extensions/README.md for the format and fields of this file"
 
-    extended-types: [deci!]
+    extended-types: [deci! deci-vector!]
 ]
 
 use-librebol: 'no
@@ -13,14 +13,27 @@ includes: [
 
 sources: [mod-deci.c]
 
+; The add, multiply and divide kernels of %deci.c can do their significand
+; arithmetic in GCC's _Decimal128 instead of 64-bit limbs, for comparing the
+; two on a deployment; the results are the same (see note [J] there).  Set
+; `deci-backend: 'decimal128` in the build config to get that.
+;
+definitions: if 'decimal128 = try user-config.deci-backend [
+    [DECI_DECIMAL128]
+]
+
+; The DECI-VECTOR! reductions run their workers on pthreads except on
+; Windows; glibc before 2.34 and other libcs keep those in a library of
+; their own.
+;
+libraries: if 'windows <> platform-config.os-base [
+    [%pthread]
+]
+
+; %deci.c is written for GCC and Clang (unsigned __int128, GCC builtins and
+; attributes), so MSVC can't build this extension; use clang-cl or MinGW on
+; Windows (see README.md).
+;
 depends: [
-    deci.c [
-        ; May 2018 update to MSVC 2017 added warnings for Spectre mitigation.
-        ; %deci.c is a lot of twiddly custom C code for implementing a fixed
-        ; precision math type, that was for some reason a priority in R3-Alpha
-        ; but isn't very central to Ren-C.  It is not a priority to audit
-        ; it for speed, so allow it to be slow if MSVC compiles with /Qspectre
-        ;
-        <msc:/wd5045>  ; https://stackoverflow.com/q/50399940
-    ]
+    deci.c
 ]
@@ -39,6 +39,11 @@
 
 #include "deci.h"
 
+#if !TO_WINDOWS
+    #include <pthread.h>
+    #include <unistd.h>  // sysconf()
+#endif
+
 #define TYPE_MONEY  TYPE_DECIMAL  // proxy, but this doesn't work anymore
 
 
@@ -67,15 +72,32 @@ INLINE deci Cell_Deci_Amount(const Cell* v) {
 }
 
 
+// INTEGER! and DECIMAL! (or PERCENT!) operands are compared as they are,
+// with no DECI! made from them.
+//
+static int32_t Compare_Deci_With(deci a, const Stable* v, const Symbol* verb)
+{
+    if (Is_Deci(v))
+        return deci_compare(a, Cell_Deci_Amount(v));
+
+    if (Is_Integer(v))
+        return deci_compare_int(a, VAL_INT64(v));
+
+    if (Is_Decimal(v) or Is_Percent(v))
+        return deci_compare_decimal(a, VAL_DECIMAL(v));
+
+    panic (Error_Math_Args(TYPE_MONEY, verb));
+}
+
+
 IMPLEMENT_GENERIC(EQUAL_Q, Is_Deci)
 {
     INCLUDE_PARAMS_OF_EQUAL_Q;
 
     deci a = Cell_Deci_Amount(ARG(VALUE1));
-    deci b = Cell_Deci_Amount(ARG(VALUE2));
     UNUSED(ARG(RELAX));
 
-    return LOGIC(deci_is_equal(a, b));
+    return LOGIC(Compare_Deci_With(a, ARG(VALUE2), CANON(EQUAL_Q)) == 0);
 }
 
 
@@ -84,12 +106,21 @@ IMPLEMENT_GENERIC(LESSER_Q, Is_Deci)
     INCLUDE_PARAMS_OF_LESSER_Q;
 
     deci a = Cell_Deci_Amount(ARG(VALUE1));
-    deci b = Cell_Deci_Amount(ARG(VALUE2));
 
-    if (deci_is_equal(a, b))
-        return LOGIC(false);
+    return LOGIC(Compare_Deci_With(a, ARG(VALUE2), CANON(LESSER_Q)) < 0);
+}
+
 
-    return LOGIC(deci_is_lesser_or_equal(a, b));
+// Equal decis can differ in their bits ($1 and $1.00, signed zeros), so the
+// hash is taken over the canonical form.
+//
+IMPLEMENT_GENERIC(HASH, Is_Deci)
+{
+    INCLUDE_PARAMS_OF_HASH;
+    UNUSED(ARG(STRICT));  // strict equality of decis isn't bitwise either
+
+    deci d = Cell_Deci_Amount(ARG(VALUE));
+    return Init_Integer(OUT, deci_hash(d));
 }
 
 
@@ -102,9 +133,8 @@ IMPLEMENT_GENERIC(ZEROIFY, Is_Deci)
 }
 
 
-// !!! The deci API is being left mostly untouched, so it doesn't return
-// Option(Error*), it just abruptly panic()s.  Try to contain the issue by
-// using RECOVER_SCOPE().
+// The deci API mostly panic()s abruptly, but the checked conversion reports
+// an invalid significand as a status flag, so no RECOVER_SCOPE() is needed.
 //
 static Result(None) Blob_To_Deci(
     Sink(Stable) out,
@@ -122,14 +152,11 @@ static Result(None) Blob_To_Deci(
     memcpy(buf + 12 - size, buf, size);  // shift to right side
     memset(buf, 0, 12 - size);
 
-    RECOVER_SCOPE_CLOBBERS_ABOVE_LOCALS_IF_MODIFIED {
-        Init_Deci(out, binary_to_deci(buf));
-        CLEANUP_BEFORE_EXITING_RECOVER_SCOPE;
-    }
-    ON_ABRUPT_PANIC (Error* e) {
-        return fail (e);
-    }
+    deci d;
+    if (binary_to_deci_checked(&d, buf) & DECI_OVERFLOW)
+        return fail (Error_Overflow_Raw());
 
+    Init_Deci(out, d);
     return none;
 }
 
@@ -244,6 +271,12 @@ IMPLEMENT_GENERIC(OLDGENERIC, Is_Deci)
         ); }
 
       case SYM_DIVIDE: {
+        if (Is_Integer(ARG_N(2)))  // quantities, no DECI! divisor needed
+            return Init_Deci(
+                OUT,
+                deci_divide_int(Cell_Deci_Amount(v), VAL_INT64(ARG_N(2)))
+            );
+
         Stable* arg = Math_Arg_For_Money(SPARE, ARG_N(2), verb);
         return Init_Deci(
             OUT,
@@ -335,6 +368,9 @@ IMPLEMENT_GENERIC(MULTIPLY, Is_Deci)
 
     deci d1 = Cell_Deci_Amount(ARG(VALUE1));  // first generic arg is money
 
+    if (Is_Integer(ARG(VALUE2)))  // amount times quantity, the common case
+        return Init_Deci(OUT, deci_multiply_int(d1, VAL_INT64(ARG(VALUE2))));
+
     Stable* money2 = Math_Arg_For_Money(SPARE, ARG(VALUE2), CANON(MULTIPLY));
     deci d2 = Cell_Deci_Amount(money2);
 
@@ -350,30 +386,38 @@ IMPLEMENT_GENERIC(ROUND, Is_Deci)
 
     Stable* to = opt ARG(TO);
     if (not to)
-        to = Init_Deci(LOCAL(TO), decimal_to_deci(1.0L));
+        to = Init_Deci(LOCAL(TO), int_to_deci(1));
 
-    deci scale = decimal_to_deci(Dec64(to));
+    deci scale;  // INTEGER! and DECI! scales are exact, not via a double
+    if (Is_Deci(to))
+        scale = Cell_Deci_Amount(to);
+    else if (Is_Integer(to))
+        scale = int_to_deci(VAL_INT64(to));
+    else
+        scale = decimal_to_deci(Dec64(to));
 
     if (deci_is_zero(scale))
         return fail (Error_Zero_Divide_Raw());
 
-    scale = deci_abs(scale);
-
-    deci d = Cell_Deci_Amount(v);;
+    int32_t mode;
     if (ARG(EVEN))
-        d = deci_half_even(d, scale);
+        mode = DECI_ROUND_HALF_EVEN;
     else if (ARG(DOWN))
-        d = deci_truncate(d, scale);
+        mode = DECI_ROUND_TRUNCATE;
     else if (ARG(HALF_DOWN))
-        d = deci_half_truncate(d, scale);
+        mode = DECI_ROUND_HALF_TRUNCATE;
     else if (ARG(FLOOR))
-        d = deci_floor(d, scale);
+        mode = DECI_ROUND_FLOOR;
     else if (ARG(CEILING))
-        d = deci_ceil(d, scale);
+        mode = DECI_ROUND_CEIL;
     else if (ARG(HALF_CEILING))
-        d = deci_half_ceil(d, scale);
+        mode = DECI_ROUND_HALF_CEIL;
     else
-        d = deci_half_away(d, scale);
+        mode = DECI_ROUND_HALF_AWAY;
+
+    // a power of ten scale like 0.01 is one decimal shift, see deci_quantize()
+    //
+    deci d = deci_round(Cell_Deci_Amount(v), scale, mode);
 
     if (Is_Decimal(to) or Is_Percent(to)) {
         Heart to_heart = Heart_Of_Builtin_Fundamental(Known_Element(to));
@@ -395,6 +439,1089 @@ IMPLEMENT_GENERIC(ROUND, Is_Deci)
 }
 
 
+#define DECI_BATCH 64  // values converted per call of the array operations
+
+
+// Applies one of the deci array operations to a block of DECI! values and
+// either a block of as many DECI! values or a single value.  The values go
+// through C arrays in chunks, so the arithmetic runs in tight loops with no
+// cell access between the elements.  The checked operations are used, so
+// errors are tested once per chunk.
+//
+static Element* Init_Deci_Batch(
+    Sink(Element) out,
+    const Element* values,
+    const Stable* value2,  // BLOCK!, or already converted by Math_Arg_For_Money
+    uint32_t (*each)(deci c[], const deci a[], const deci b[], size_t n),
+    uint32_t (*scalar)(deci c[], const deci a[], deci b, size_t n)
+){
+    deci a[DECI_BATCH];
+    deci b[DECI_BATCH];
+    deci c[DECI_BATCH];
+
+    const Element* tail;
+    const Element* at = List_At(&tail, values);
+
+    const Element* tail2 = nullptr;
+    const Element* at2 = nullptr;
+    if (Is_Block(value2)) {
+        at2 = List_At(&tail2, Known_Element(value2));
+        if (tail2 - at2 != tail - at)
+            panic (Error_Bad_Value(value2));
+    }
+
+    StackIndex base = TOP_INDEX;
+
+    while (at != tail) {
+        size_t n = 0;
+        for (; at != tail and n < DECI_BATCH; ++at, ++n) {
+            if (not Is_Deci(at)) {
+                Drop_Data_Stack_To(base);
+                panic (Error_Bad_Value(at));
+            }
+            a[n] = Cell_Deci_Amount(at);
+
+            if (not at2)
+                continue;
+
+            if (not Is_Deci(at2)) {
+                Drop_Data_Stack_To(base);
+                panic (Error_Bad_Value(at2));
+            }
+            b[n] = Cell_Deci_Amount(at2);
+            ++at2;
+        }
+
+        uint32_t status;
+        if (at2)
+            status = each(c, a, b, n);
+        else
+            status = scalar(c, a, Cell_Deci_Amount(value2), n);
+
+        if (status & (DECI_OVERFLOW | DECI_DIVIDE_BY_ZERO)) {
+            Drop_Data_Stack_To(base);
+            if (status & DECI_DIVIDE_BY_ZERO)
+                panic (Error_Zero_Divide_Raw());
+            panic (Error_Overflow_Raw());
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            Init_Deci(PUSH(), c[i]);
+    }
+
+    return Init_Block(out, Pop_Source_From_Stack(base));
+}
+
+
+//
+//  export add-each: native [
+//
+//  "Add DECI! values of two blocks pairwise, or one value to each"
+//
+//      return: [block!]
+//      values "Block of DECI! values"
+//          [block!]
+//      value2 "Block of as many DECI! values, or the value to add to each"
+//          [block! deci! integer! decimal! percent!]
+//  ]
+//
+DECLARE_NATIVE(ADD_EACH)
+{
+    INCLUDE_PARAMS_OF_ADD_EACH;
+
+    Stable* value2 = ARG(VALUE2);
+    if (not Is_Block(value2))
+        value2 = Math_Arg_For_Money(SPARE, value2, CANON(ADD));
+
+    return Init_Deci_Batch(
+        OUT,
+        Element_ARG(VALUES),
+        value2,
+        &deci_add_n_checked,
+        &deci_add_scalar_n_checked
+    );
+}
+
+
+//
+//  export subtract-each: native [
+//
+//  "Subtract DECI! values of two blocks pairwise, or one value from each"
+//
+//      return: [block!]
+//      values "Block of DECI! values"
+//          [block!]
+//      value2 "Block of as many DECI! values, or the value to subtract"
+//          [block! deci! integer! decimal! percent!]
+//  ]
+//
+DECLARE_NATIVE(SUBTRACT_EACH)
+{
+    INCLUDE_PARAMS_OF_SUBTRACT_EACH;
+
+    Stable* value2 = ARG(VALUE2);
+    if (not Is_Block(value2))
+        value2 = Math_Arg_For_Money(SPARE, value2, CANON(SUBTRACT));
+
+    return Init_Deci_Batch(
+        OUT,
+        Element_ARG(VALUES),
+        value2,
+        &deci_subtract_n_checked,
+        &deci_subtract_scalar_n_checked
+    );
+}
+
+
+//
+//  export multiply-each: native [
+//
+//  "Multiply DECI! values of two blocks pairwise, or each by one value"
+//
+//      return: [block!]
+//      values "Block of DECI! values"
+//          [block!]
+//      value2 "Block of as many DECI! values, or the factor for each"
+//          [block! deci! integer! decimal! percent!]
+//  ]
+//
+DECLARE_NATIVE(MULTIPLY_EACH)
+{
+    INCLUDE_PARAMS_OF_MULTIPLY_EACH;
+
+    Stable* value2 = ARG(VALUE2);
+    if (not Is_Block(value2))
+        value2 = Math_Arg_For_Money(SPARE, value2, CANON(MULTIPLY));
+
+    return Init_Deci_Batch(
+        OUT,
+        Element_ARG(VALUES),
+        value2,
+        &deci_multiply_n_checked,
+        &deci_multiply_scalar_n_checked
+    );
+}
+
+
+//
+//  export divide-each: native [
+//
+//  "Divide DECI! values of two blocks pairwise, or each by one divisor"
+//
+//      return: [block!]
+//      values "Block of DECI! values"
+//          [block!]
+//      divisor "Block of as many DECI! values, or one divisor, prepared once"
+//          [block! deci! integer! decimal! percent!]
+//  ]
+//
+DECLARE_NATIVE(DIVIDE_EACH)
+{
+    INCLUDE_PARAMS_OF_DIVIDE_EACH;
+
+    Stable* divisor = ARG(DIVISOR);
+    if (not Is_Block(divisor))
+        divisor = Math_Arg_For_Money(SPARE, divisor, CANON(DIVIDE));
+
+    return Init_Deci_Batch(
+        OUT,
+        Element_ARG(VALUES),
+        divisor,
+        &deci_divide_n_checked,
+        &deci_divide_scalar_n_checked
+    );
+}
+
+
+//
+//  export fma: native [
+//
+//  "Multiply two values and add a third, rounding only once"
+//
+//      return: [deci!]
+//      value1 [deci! integer! decimal! percent!]
+//      value2 [deci! integer! decimal! percent!]
+//      addend [deci! integer! decimal! percent!]
+//  ]
+//
+DECLARE_NATIVE(FMA)
+{
+    INCLUDE_PARAMS_OF_FMA;
+
+    deci a = Cell_Deci_Amount(
+        Math_Arg_For_Money(SPARE, ARG(VALUE1), CANON(MULTIPLY))
+    );
+    deci b = Cell_Deci_Amount(
+        Math_Arg_For_Money(SPARE, ARG(VALUE2), CANON(MULTIPLY))
+    );
+    deci c = Cell_Deci_Amount(
+        Math_Arg_For_Money(SPARE, ARG(ADDEND), CANON(ADD))
+    );
+
+    return Init_Deci(OUT, deci_fma(a, b, c));
+}
+
+
+//
+//  export sum-exact: native [
+//
+//  "Sum a block of DECI! values without rounding until the final result"
+//
+//      return: [deci!]
+//      values "Block of DECI! values"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(SUM_EXACT)
+{
+    INCLUDE_PARAMS_OF_SUM_EXACT;
+
+    deci_accumulator acc;
+    deci_accumulator_init(&acc);
+
+    const Element* tail;
+    const Element* at = List_At(&tail, Element_ARG(VALUES));
+    for (; at != tail; ++at) {
+        if (not Is_Deci(at))
+            panic (Error_Bad_Value(at));
+        deci_accumulate(&acc, Cell_Deci_Amount(at));
+    }
+
+    return Init_Deci(OUT, deci_accumulator_result(&acc));
+}
+
+
+//
+//  export dot-product: native [
+//
+//  "Sum the products of DECI! values paired from two blocks, rounding once"
+//
+//      return: [deci!]
+//      values1 "Block of DECI! values"
+//          [block!]
+//      values2 "Block of as many DECI! values"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(DOT_PRODUCT)
+{
+    INCLUDE_PARAMS_OF_DOT_PRODUCT;
+
+    const Element* tail1;
+    const Element* at1 = List_At(&tail1, Element_ARG(VALUES1));
+    const Element* tail2;
+    const Element* at2 = List_At(&tail2, Element_ARG(VALUES2));
+    if (tail2 - at2 != tail1 - at1)
+        panic (Error_Bad_Value(ARG(VALUES2)));
+
+    deci_accumulator acc;
+    deci_accumulator_init(&acc);
+
+    for (; at1 != tail1; ++at1, ++at2) {
+        if (not Is_Deci(at1))
+            panic (Error_Bad_Value(at1));
+        if (not Is_Deci(at2))
+            panic (Error_Bad_Value(at2));
+        deci_accumulate_product(
+            &acc, Cell_Deci_Amount(at1), Cell_Deci_Amount(at2)
+        );
+    }
+
+    return Init_Deci(OUT, deci_accumulator_result(&acc));
+}
+
+
+//
+//  export sort-deci: native [
+//
+//  "Sort a block of DECI! values numerically into a new block"
+//
+//      return: [block!]
+//      values "Block of DECI! values"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(SORT_DECI)
+//
+// This is a radix sort over the order-preserving keys of deci_to_key(), so
+// there is no comparison dispatch at all.  It is stable: equal values like
+// $1 and $1.00 keep their order.
+{
+    INCLUDE_PARAMS_OF_SORT_DECI;
+
+    const Element* tail;
+    const Element* at = List_At(&tail, Element_ARG(VALUES));
+    size_t n = tail - at;
+
+    deci* values = rebAllocN(deci, n);
+    deci_sort_item* scratch = rebAllocN(deci_sort_item, 2 * n);
+
+    for (size_t i = 0; i < n; ++i, ++at) {
+        if (not Is_Deci(at))
+            panic (Error_Bad_Value(at));
+        values[i] = Cell_Deci_Amount(at);
+    }
+
+    deci_sort_n(values, n, scratch);
+    rebFree(scratch);
+
+    StackIndex base = TOP_INDEX;
+    for (size_t i = 0; i < n; ++i)
+        Init_Deci(PUSH(), values[i]);
+    rebFree(values);
+
+    return Init_Block(OUT, Pop_Source_From_Stack(base));
+}
+
+//=//// DECI-VECTOR! //////////////////////////////////////////////////////=//
+//
+// A packed vector of decis.  A BLOCK! of DECI! spends a whole Cell on each
+// 12-byte value; this keeps the significands, exponents and signs in the
+// columns of deci_columns_at(), 14 bytes per value, in one Binary that the
+// cell's first payload slot points to (so the GC marks it).
+//
+// The Binary starts with a DeciVectorHeader, and the columns start at the
+// first 64-byte address after it, so each column is cache-aligned (see
+// deci_columns_at()).  The Binary has 63 bytes of slack for that; where the
+// boundary falls depends on where the data is, so when growing moves the
+// data, Deci_Vector_Append() realigns the columns.
+//
+
+typedef struct {
+    size_t len;  // values in use
+    size_t cap;  // values the columns are laid out for
+} DeciVectorHeader;
+
+#define DECI_VECTOR_SLACK (sizeof(DeciVectorHeader) + 63)  // before columns
+
+
+INLINE Element* Init_Deci_Vector(Init(Element) out, Binary* bin) {
+    Reset_Extended_Cell_Header_Noquote(
+        out,
+        EXTRA_HEART_DECI_VECTOR,
+        CELL_FLAG_DONT_MARK_PAYLOAD_2  // payload 1 is the Binary, marked
+    );
+    out->payload.split.one.base = bin;
+    return out;
+}
+
+
+INLINE Binary* Cell_Deci_Vector(const Cell* v) {
+    assert(Is_Deci_Vector(v));
+    return cast(Binary*, v->payload.split.one.base);
+}
+
+
+INLINE DeciVectorHeader* Deci_Vector_Header(Binary* bin) {
+    return cast(DeciVectorHeader*, Binary_Head(bin));
+}
+
+
+INLINE Byte* Deci_Align_64(Byte* at) {  // first 64-byte address from `at`
+    return at + (64 - cast(uintptr_t, at) % 64) % 64;
+}
+
+
+INLINE Byte* Deci_Vector_Base(Binary* bin) {
+    return Deci_Align_64(Binary_Head(bin) + sizeof(DeciVectorHeader));
+}
+
+
+INLINE void Get_Deci_Vector_Columns(deci_columns* columns, Binary* bin) {
+    deci_columns_at(
+        columns,
+        Deci_Vector_Base(bin),
+        Deci_Vector_Header(bin)->cap
+    );
+}
+
+
+static Binary* Make_Deci_Vector(size_t cap) {
+    Size size = DECI_VECTOR_SLACK + deci_columns_size(cap);
+    Binary* bin = Make_Binary(size);
+    Term_Binary_Len(bin, size);
+
+    DeciVectorHeader* header = Deci_Vector_Header(bin);
+    header->len = 0;
+    header->cap = cap;
+
+    Manage_Flex(bin);
+    return bin;
+}
+
+
+static void Deci_Vector_Append(Binary* bin, deci d) {
+    DeciVectorHeader* header = Deci_Vector_Header(bin);
+
+    if (header->len == header->cap) {  // grow the Binary, then the columns
+        size_t cap = header->cap ? 2 * header->cap : 8;
+        Size offset = Deci_Vector_Base(bin) - Binary_Head(bin);
+        require (
+          Expand_Flex_Tail(
+            bin, deci_columns_size(cap) - deci_columns_size(header->cap)
+          )
+        );
+        header = Deci_Vector_Header(bin);  // data may have moved
+        Byte* base = Deci_Vector_Base(bin);
+        if (base != Binary_Head(bin) + offset)  // moved off the boundary
+            memmove(
+                base,
+                Binary_Head(bin) + offset,
+                deci_columns_size(header->cap)
+            );
+        deci_columns_move(base, header->cap, cap, header->len);
+        header->cap = cap;
+    }
+
+    deci_columns columns;
+    Get_Deci_Vector_Columns(&columns, bin);
+    deci_columns_put(&columns, header->len, d);
+    ++header->len;
+}
+
+
+// 1-based index into the vector, or an out of range error.
+//
+static size_t Deci_Vector_Index(Binary* bin, const Stable* picker) {
+    if (not Is_Integer(picker))
+        panic (Error_Bad_Value(picker));
+
+    REBI64 i = VAL_INT64(picker);
+    if (i < 1 or cast(size_t, i) > Deci_Vector_Header(bin)->len)
+        panic (Error_Out_Of_Range(picker));
+
+    return i - 1;
+}
+
+
+// Like Init_Deci_Batch(), with the values coming from the columns of a
+// DECI-VECTOR! and going to those of a new one.  Two vectors are combined by
+// `columns` directly if given (the SIMD kernels), else batch by batch.
+//
+static Element* Init_Deci_Vector_Batch(
+    Sink(Element) out,
+    const Element* vector,
+    const Stable* value2,  // DECI-VECTOR!, or converted by Math_Arg_For_Money
+    uint32_t (*each)(deci c[], const deci a[], const deci b[], size_t n),
+    uint32_t (*scalar)(deci c[], const deci a[], deci b, size_t n),
+    uint32_t (*columns)(  // or nullptr
+        const deci_columns* c,
+        const deci_columns* a,
+        const deci_columns* b,
+        size_t n
+    )
+){
+    deci a[DECI_BATCH];
+    deci b[DECI_BATCH];
+    deci c[DECI_BATCH];
+
+    Binary* bin_a = Cell_Deci_Vector(vector);
+    size_t len = Deci_Vector_Header(bin_a)->len;
+
+    Binary* bin_b = nullptr;
+    if (Is_Deci_Vector(value2)) {
+        bin_b = Cell_Deci_Vector(value2);
+        if (Deci_Vector_Header(bin_b)->len != len)
+            panic (Error_Bad_Value(value2));
+    }
+
+    Binary* bin_c = Make_Deci_Vector(len);
+    Deci_Vector_Header(bin_c)->len = len;
+
+    deci_columns columns_a;
+    deci_columns columns_b;
+    deci_columns columns_c;
+    Get_Deci_Vector_Columns(&columns_a, bin_a);
+    if (bin_b)
+        Get_Deci_Vector_Columns(&columns_b, bin_b);
+    Get_Deci_Vector_Columns(&columns_c, bin_c);
+
+    if (bin_b and columns) {
+        uint32_t status = columns(
+            &columns_c, &columns_a, &columns_b, len
+        );
+        if (status & DECI_OVERFLOW)
+            panic (Error_Overflow_Raw());
+        return Init_Deci_Vector(out, bin_c);
+    }
+
+    for (size_t i = 0; i < len; i += DECI_BATCH) {
+        size_t n = len - i < DECI_BATCH ? len - i : DECI_BATCH;
+
+        deci_columns_get_n(a, &columns_a, i, n);
+
+        uint32_t status;
+        if (bin_b) {
+            deci_columns_get_n(b, &columns_b, i, n);
+            status = each(c, a, b, n);
+        }
+        else
+            status = scalar(c, a, Cell_Deci_Amount(value2), n);
+
+        if (status & DECI_DIVIDE_BY_ZERO)
+            panic (Error_Zero_Divide_Raw());
+        if (status & DECI_OVERFLOW)
+            panic (Error_Overflow_Raw());
+
+        deci_columns_put_n(&columns_c, i, c, n);
+    }
+
+    return Init_Deci_Vector(out, bin_c);
+}
+
+
+// Second argument of the vector arithmetic: another DECI-VECTOR!, or a
+// value for Math_Arg_For_Money().
+//
+static Stable* Vector_Arg_For_Money(
+    Sink(Stable) store,
+    Stable* arg,
+    const Symbol* verb
+){
+    if (Is_Deci_Vector(arg))
+        return arg;
+
+    return Math_Arg_For_Money(store, arg, verb);
+}
+
+
+IMPLEMENT_GENERIC(MAKE, Is_Deci_Vector)
+{
+    INCLUDE_PARAMS_OF_MAKE;  // [integer! block!]
+    UNUSED(ARG(TYPE));
+
+    Element* arg = Element_ARG(DEF);
+
+    if (Is_Integer(arg)) {  // empty, with room for that many values
+        if (VAL_INT64(arg) < 0)
+            panic (Error_Out_Of_Range(arg));
+        return Init_Deci_Vector(OUT, Make_Deci_Vector(VAL_INT64(arg)));
+    }
+
+    if (not Is_Block(arg))
+        panic (PARAM(DEF));
+
+    const Element* tail;
+    const Element* at = List_At(&tail, arg);
+
+    Binary* bin = Make_Deci_Vector(tail - at);
+
+    deci_columns columns;
+    Get_Deci_Vector_Columns(&columns, bin);
+
+    size_t i = 0;
+    for (; at != tail; ++at, ++i) {
+        if (not Is_Deci(at))
+            panic (Error_Bad_Value(at));
+        deci_columns_put(&columns, i, Cell_Deci_Amount(at));
+    }
+    Deci_Vector_Header(bin)->len = i;
+
+    return Init_Deci_Vector(OUT, bin);
+}
+
+
+IMPLEMENT_GENERIC(MOLDIFY, Is_Deci_Vector)
+{
+    INCLUDE_PARAMS_OF_MOLDIFY;
+
+    Element* v = Element_ARG(VALUE);
+    Molder* mo = Cell_Handle_Pointer(Molder, ARG(MOLDER));
+    bool form = did ARG(FORM);
+
+    UNUSED(form);
+
+    Begin_Non_Lexical_Mold(mo, v);  // deci_to_string adds the spaces
+
+    Binary* bin = Cell_Deci_Vector(v);
+    deci_columns columns;
+    Get_Deci_Vector_Columns(&columns, bin);
+
+    size_t len = Deci_Vector_Header(bin)->len;
+    for (size_t i = 0; i < len; ++i) {
+        Byte buf[60];
+        REBINT n = deci_to_string(
+            buf, deci_columns_get(&columns, i), ' ', '.'
+        );
+        require (
+          Append_Ascii_Len(mo->strand, s_cast(buf), n)
+        );
+    }
+
+    End_Non_Lexical_Mold(mo);
+
+    return TRASH;
+}
+
+
+IMPLEMENT_GENERIC(TO, Is_Deci_Vector)
+{
+    INCLUDE_PARAMS_OF_TO;
+
+    Element* v = Element_ARG(VALUE);
+    Heart to = Datatype_Builtin_Heart(ARG(TYPE));
+
+    if (to != TYPE_BLOCK)
+        panic (UNHANDLED);
+
+    Binary* bin = Cell_Deci_Vector(v);
+    deci_columns columns;
+    Get_Deci_Vector_Columns(&columns, bin);
+
+    StackIndex base = TOP_INDEX;
+
+    size_t len = Deci_Vector_Header(bin)->len;
+    for (size_t i = 0; i < len; ++i)
+        Init_Deci(PUSH(), deci_columns_get(&columns, i));
+
+    return Init_Block(OUT, Pop_Source_From_Stack(base));
+}
+
+
+IMPLEMENT_GENERIC(OLDGENERIC, Is_Deci_Vector)
+{
+    const Symbol* verb = Level_Verb(LEVEL);
+    Option(SymId) id = Symbol_Id(verb);
+
+    Element* v = cast(Element*, ARG_N(1));
+    Binary* bin = Cell_Deci_Vector(v);
+
+    switch (opt id) {
+      case SYM_ADD: {
+        Stable* arg = Vector_Arg_For_Money(SPARE, ARG_N(2), verb);
+        return Init_Deci_Vector_Batch(
+            OUT,
+            v,
+            arg,
+            &deci_add_n_checked,
+            &deci_add_scalar_n_checked,
+            &deci_columns_add_n
+        ); }
+
+      case SYM_SUBTRACT: {
+        Stable* arg = Vector_Arg_For_Money(SPARE, ARG_N(2), verb);
+        return Init_Deci_Vector_Batch(
+            OUT,
+            v,
+            arg,
+            &deci_subtract_n_checked,
+            &deci_subtract_scalar_n_checked,
+            &deci_columns_subtract_n
+        ); }
+
+      case SYM_DIVIDE: {
+        Stable* arg = Vector_Arg_For_Money(SPARE, ARG_N(2), verb);
+        return Init_Deci_Vector_Batch(
+            OUT,
+            v,
+            arg,
+            &deci_divide_n_checked,
+            &deci_divide_scalar_n_checked,
+            nullptr
+        ); }
+
+      case SYM_PICK: {
+        size_t i = Deci_Vector_Index(bin, ARG_N(2));
+        deci_columns columns;
+        Get_Deci_Vector_Columns(&columns, bin);
+        return Init_Deci(OUT, deci_columns_get(&columns, i)); }
+
+      case SYM_POKE: {
+        size_t i = Deci_Vector_Index(bin, ARG_N(2));
+        Stable* arg = Math_Arg_For_Money(SPARE, ARG_N(3), verb);
+        deci_columns columns;
+        Get_Deci_Vector_Columns(&columns, bin);
+        deci_columns_put(&columns, i, Cell_Deci_Amount(arg));
+        return COPY(ARG_N(3)); }
+
+      case SYM_APPEND: {
+        Stable* arg = Math_Arg_For_Money(SPARE, ARG_N(2), verb);
+        Deci_Vector_Append(bin, Cell_Deci_Amount(arg));
+        return COPY(v); }
+
+      default:
+        break;
+    }
+
+    panic (UNHANDLED);
+}
+
+
+IMPLEMENT_GENERIC(MULTIPLY, Is_Deci_Vector)
+{
+    INCLUDE_PARAMS_OF_MULTIPLY;
+
+    Element* v = Element_ARG(VALUE1);  // first generic arg is the vector
+
+    Stable* arg = Vector_Arg_For_Money(
+        SPARE, ARG(VALUE2), CANON(MULTIPLY)
+    );
+    return Init_Deci_Vector_Batch(
+        OUT,
+        v,
+        arg,
+        &deci_multiply_n_checked,
+        &deci_multiply_scalar_n_checked,
+        nullptr
+    );
+}
+
+
+// Compares the values of two DECI-VECTOR!s pairwise, as deci_compare() does,
+// with the column kernels.  The result array holds `len` values.
+//
+static int8_t* Compare_Deci_Vectors(
+    Binary* bin1,
+    const Stable* vector2,
+    size_t len
+){
+    Binary* bin2 = Cell_Deci_Vector(vector2);
+    if (Deci_Vector_Header(bin2)->len != len)
+        panic (Error_Bad_Value(vector2));
+
+    deci_columns columns1;
+    deci_columns columns2;
+    Get_Deci_Vector_Columns(&columns1, bin1);
+    Get_Deci_Vector_Columns(&columns2, bin2);
+
+    int8_t* r = rebAllocN(int8_t, len + 1);  // + 1, never a zero size
+    deci_columns_compare_n(r, &columns1, &columns2, len);
+    return r;
+}
+
+
+IMPLEMENT_GENERIC(EQUAL_Q, Is_Deci_Vector)
+{
+    INCLUDE_PARAMS_OF_EQUAL_Q;
+    UNUSED(ARG(RELAX));
+
+    Binary* bin1 = Cell_Deci_Vector(ARG(VALUE1));
+    size_t len = Deci_Vector_Header(bin1)->len;
+    if (Deci_Vector_Header(Cell_Deci_Vector(ARG(VALUE2)))->len != len)
+        return LOGIC(false);
+
+    int8_t* r = Compare_Deci_Vectors(bin1, ARG(VALUE2), len);
+    size_t i = 0;
+    while (i < len and r[i] == 0)
+        ++i;
+    rebFree(r);
+
+    return LOGIC(i == len);
+}
+
+
+//
+//  export vector-compare: native [
+//
+//  "Compare two DECI-VECTOR!s value by value, giving -1, 0 or 1 for each"
+//
+//      return: [block!]
+//      vector1 [deci-vector!]
+//      vector2 "Vector of as many values"
+//          [deci-vector!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_COMPARE)
+{
+    INCLUDE_PARAMS_OF_VECTOR_COMPARE;
+
+    Binary* bin1 = Cell_Deci_Vector(ARG(VECTOR1));
+    size_t len = Deci_Vector_Header(bin1)->len;
+    int8_t* r = Compare_Deci_Vectors(bin1, ARG(VECTOR2), len);
+
+    StackIndex base = TOP_INDEX;
+    for (size_t i = 0; i < len; ++i)
+        Init_Integer(PUSH(), r[i]);
+    rebFree(r);
+
+    return Init_Block(OUT, Pop_Source_From_Stack(base));
+}
+
+
+//
+//  export vector-scale: native [
+//
+//  "Multiply each value of a DECI-VECTOR! by a power of ten, exactly"
+//
+//      return: [deci-vector!]
+//      vector [deci-vector!]
+//      exponent "Power of ten to multiply by"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_SCALE)
+{
+    INCLUDE_PARAMS_OF_VECTOR_SCALE;
+
+    Binary* bin_a = Cell_Deci_Vector(ARG(VECTOR));
+    size_t len = Deci_Vector_Header(bin_a)->len;
+
+    REBI64 k = VAL_INT64(ARG(EXPONENT));  // beyond 1000, all over or under
+    if (k > 1000)
+        k = 1000;
+    else if (k < -1000)
+        k = -1000;
+
+    Binary* bin_c = Make_Deci_Vector(len);
+    Deci_Vector_Header(bin_c)->len = len;
+
+    deci_columns columns_a;
+    deci_columns columns_c;
+    Get_Deci_Vector_Columns(&columns_a, bin_a);
+    Get_Deci_Vector_Columns(&columns_c, bin_c);
+
+    uint32_t status = deci_columns_ldexp_n(
+        &columns_c, &columns_a, cast(int32_t, k), len
+    );
+    if (status & DECI_OVERFLOW)
+        panic (Error_Overflow_Raw());
+
+    return Init_Deci_Vector(OUT, bin_c);
+}
+
+
+//=//// PARALLEL REDUCTIONS ///////////////////////////////////////////////=//
+//
+// The reductions of a DECI-VECTOR! split its columns into consecutive parts,
+// one per worker thread, and merge the deci_totals of the parts in order.
+// A BLOCK! of DECI! is first copied into temporary columns, on the calling
+// thread, and reduced the same way.
+// The sums are exact and ties between equal values go to the first one, so
+// the result is the same bit for bit for any number of threads.
+//
+// The workers only read the columns and write their own totals; they never
+// touch cells or the GC, which remain single-threaded.  (Windows builds run
+// the parts one after another on the calling thread for now.)
+//
+
+#define DECI_VALUES_PER_WORKER  65536  // below this, threads cost more
+
+typedef struct {
+    const deci_columns* columns;
+    size_t i;
+    size_t n;
+    deci_totals totals;
+} DeciReduceJob;
+
+static void* Deci_Reduce_Job(void* p) {
+    DeciReduceJob* job = cast(DeciReduceJob*, p);
+    deci_totals_init(&job->totals);
+    deci_totals_columns(&job->totals, job->columns, job->i, job->n);
+    return nullptr;
+}
+
+static REBINT Deci_Default_Threads(void) {
+  #if TO_WINDOWS
+    return 1;
+  #else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n < 1 ? 1 : cast(REBINT, n);
+  #endif
+}
+
+
+// Totals of the first `len` values of some columns, over at most `threads`
+// workers (the calling thread is one of them).
+//
+static void Reduce_Deci_Columns(
+    deci_totals* totals,
+    const deci_columns* columns,
+    size_t len,
+    REBINT threads
+){
+    size_t workers = len / DECI_VALUES_PER_WORKER;
+    if (workers > cast(size_t, threads))
+        workers = threads;
+    if (workers < 1)
+        workers = 1;
+
+    DeciReduceJob* jobs = rebAllocN(DeciReduceJob, workers);
+    for (size_t w = 0; w < workers; ++w) {
+        jobs[w].columns = columns;
+        jobs[w].i = len * w / workers;
+        jobs[w].n = len * (w + 1) / workers - jobs[w].i;
+    }
+
+  #if TO_WINDOWS
+    for (size_t w = 0; w < workers; ++w)
+        Deci_Reduce_Job(&jobs[w]);
+  #else
+    pthread_t* ids = rebAllocN(pthread_t, workers);
+    size_t started = 1;
+    for (; started < workers; ++started)
+        if (pthread_create(
+            &ids[started], nullptr, &Deci_Reduce_Job, &jobs[started]
+        )){
+            break;  // run the rest here
+        }
+    Deci_Reduce_Job(&jobs[0]);
+    for (size_t w = started; w < workers; ++w)
+        Deci_Reduce_Job(&jobs[w]);
+    for (size_t w = 1; w < started; ++w)
+        pthread_join(ids[w], nullptr);
+    rebFree(ids);
+  #endif
+
+    deci_totals_init(totals);
+    for (size_t w = 0; w < workers; ++w)
+        deci_totals_merge(totals, &jobs[w].totals);
+    rebFree(jobs);
+}
+
+
+// Totals of a DECI-VECTOR!, or of a BLOCK! of DECI! put in columns first.
+//
+static void Reduce_Deci_Values(
+    deci_totals* totals,
+    const Element* values,
+    REBINT threads
+){
+    deci_columns columns;
+
+    if (Is_Deci_Vector(values)) {
+        Binary* bin = Cell_Deci_Vector(values);
+        Get_Deci_Vector_Columns(&columns, bin);
+        Reduce_Deci_Columns(
+            totals, &columns, Deci_Vector_Header(bin)->len, threads
+        );
+        return;
+    }
+
+    const Element* tail;
+    const Element* at = List_At(&tail, values);
+    size_t len = tail - at;
+
+    Byte* buf = rebAllocN(Byte, deci_columns_size(len) + 63);  // to align
+    deci_columns_at(&columns, Deci_Align_64(buf), len);
+    for (size_t i = 0; i < len; ++i, ++at) {
+        if (not Is_Deci(at))
+            panic (Error_Bad_Value(at));
+        deci_columns_put(&columns, i, Cell_Deci_Amount(at));
+    }
+
+    Reduce_Deci_Columns(totals, &columns, len, threads);
+    rebFree(buf);
+}
+
+
+static REBINT Deci_Threads_Arg(const Stable* threads) {  // or nullptr
+    if (not threads)
+        return Deci_Default_Threads();
+
+    REBI64 n = VAL_INT64(threads);
+    if (n < 1)
+        panic (Error_Out_Of_Range(threads));
+    return n > INT32_MAX ? INT32_MAX : cast(REBINT, n);
+}
+
+
+//
+//  export vector-sum: native [
+//
+//  "Exact sum of DECI! values, rounded once, reduced over worker threads"
+//
+//      return: [deci!]
+//      values "DECI-VECTOR!, or block of DECI! values"
+//          [deci-vector! block!]
+//      :threads "Most threads to use (default is one per processor)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_SUM)
+{
+    INCLUDE_PARAMS_OF_VECTOR_SUM;
+
+    deci_totals totals;
+    Reduce_Deci_Values(
+        &totals,
+        Element_ARG(VALUES),
+        Deci_Threads_Arg(opt ARG(THREADS))
+    );
+    return Init_Deci(OUT, deci_accumulator_result(&totals.sum));
+}
+
+
+//
+//  export vector-min: native [
+//
+//  "Smallest of non-empty DECI! values, the first one of equal values"
+//
+//      return: [deci!]
+//      values "DECI-VECTOR!, or block of DECI! values"
+//          [deci-vector! block!]
+//      :threads "Most threads to use (default is one per processor)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_MIN)
+{
+    INCLUDE_PARAMS_OF_VECTOR_MIN;
+
+    deci_totals totals;
+    Reduce_Deci_Values(
+        &totals,
+        Element_ARG(VALUES),
+        Deci_Threads_Arg(opt ARG(THREADS))
+    );
+    if (totals.n == 0)
+        panic (Error_Bad_Value(ARG(VALUES)));
+    return Init_Deci(OUT, totals.min);
+}
+
+
+//
+//  export vector-max: native [
+//
+//  "Largest of non-empty DECI! values, the first one of equal values"
+//
+//      return: [deci!]
+//      values "DECI-VECTOR!, or block of DECI! values"
+//          [deci-vector! block!]
+//      :threads "Most threads to use (default is one per processor)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_MAX)
+{
+    INCLUDE_PARAMS_OF_VECTOR_MAX;
+
+    deci_totals totals;
+    Reduce_Deci_Values(
+        &totals,
+        Element_ARG(VALUES),
+        Deci_Threads_Arg(opt ARG(THREADS))
+    );
+    if (totals.n == 0)
+        panic (Error_Bad_Value(ARG(VALUES)));
+    return Init_Deci(OUT, totals.max);
+}
+
+
+//
+//  export vector-count: native [
+//
+//  "Number of nonzero DECI! values, counted over worker threads"
+//
+//      return: [integer!]
+//      values "DECI-VECTOR!, or block of DECI! values"
+//          [deci-vector! block!]
+//      :threads "Most threads to use (default is one per processor)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(VECTOR_COUNT)
+{
+    INCLUDE_PARAMS_OF_VECTOR_COUNT;
+
+    deci_totals totals;
+    Reduce_Deci_Values(
+        &totals,
+        Element_ARG(VALUES),
+        Deci_Threads_Arg(opt ARG(THREADS))
+    );
+    return Init_Integer(OUT, totals.nonzero);
+}
+
 //
 //  startup*: native [
 //
@@ -0,0 +1,338 @@
+; %deci.test.r
+;
+; Tests for the DECI! extension datatype (the "deci" math from R3-Alpha's
+; MONEY!, see %money-math.test.r for the historical tests).
+;
+; Values are built from INTEGER! and DECIMAL! so the significands are exact.
+;
+; The results must be the same with the _Decimal128 kernels (built with
+; DECI_DECIMAL128, see note [J] of %deci.c) as with the default ones.
+
+
+; a subtraction can leave 27 digits after aligning the operands, the
+; difference has to be normalized like a sum
+(
+    a: (make deci! 5000000000000000000) * (make deci! 1e7)
+    a = (a - (make deci! 0.1))
+)
+
+; results of over 34 digits that a rounding to 34 digits would turn into ties
+; at 26 digits, the _Decimal128 kernels must round them only once
+(
+    e12: make deci! 1000000000000
+    e13: make deci! 10000000000000
+    a: (e13 * e12) + 1  ; 1e25 + 1
+    b: (make deci! 15) * e12 * e12 + 1
+    all [
+        ((make deci! 1500000000000) * e13 + 3) * e13 * e12 = a * b
+        (a + 2) = (a + 1) + ((make deci! 0.5) + (make deci! 1) * (make deci! 1e-20))
+    ]
+)
+
+; comparison by magnitude first, aligning the significands only on a tie
+(
+    a: (make deci! 125) * (make deci! 1e20)
+    b: (make deci! 12500000000000000000) * (make deci! 1e4)  ; same value
+    all [
+        a = b
+        not lesser? a b
+        lesser? a (b + (make deci! 1e4))
+        lesser? (negate a) (make deci! 0)
+        (make deci! 0) = negate (make deci! 0)
+    ]
+)
+(
+    values: reduce [make deci! 2.5 make deci! -1 make deci! 1e-20 make deci! 0.25]
+    (reduce [values.2 values.3 values.4 values.1]) = sort copy values
+)
+
+; ROUND to a power of ten drops the digits in one decimal shift, other
+; scales go through the remainder; results are those of the remainder way,
+; with the exponent of the scale
+(
+    x: make deci! 2.665
+    cent: make deci! 0.01
+    all [
+        (make deci! 2.67) = round:to x cent
+        (make deci! 2.66) = round:to:even x cent
+        (make deci! 2.66) = round:to:down x cent
+        (make deci! 2.66) = round:to:half-down x cent
+        (make deci! 2.67) = round:to:ceiling x cent
+        (make deci! -2.67) = round:to:floor negate x cent
+        (make deci! -2.66) = round:to:half-ceiling negate x cent
+        (make deci! 2.68) = round:to:even make deci! 2.675 cent
+        2.67 = round:to x 0.01
+        (make deci! 3) = round x
+        (mold make deci! 1200) = mold round:to (make deci! 1234.5) make deci! 100
+        (make deci! 2.7) = round:to x make deci! 0.3
+        (make deci! 0) = round:to (make deci! 0.004) cent
+    ]
+)
+~zero-divide~ !! (round:to make deci! 1 0)
+
+; INTEGER! multipliers and divisors take the one-limb kernels, the results
+; must be those with the integer made a DECI! first
+(
+    a: (make deci! 12345678901234567) * (make deci! 987654321) + (make deci! 0.5)
+    all [
+        (a * make deci! 3) = a * 3
+        (a * make deci! -1000) = a * -1000
+        (a * make deci! 9007199254740993) = a * 9007199254740993
+        (a / make deci! 7) = a / 7
+        (a / make deci! -12345678901) = a / -12345678901
+        (make deci! 0.05) = (make deci! 1) / 20
+        (make deci! 59.97) = (make deci! 19.99) * 3
+    ]
+)
+~zero-divide~ !! ((make deci! 1) / 0)
+
+; comparison with INTEGER! and DECIMAL! makes no DECI! of them, a DECIMAL!
+; compares as its shortest decimal, as the conversion makes it
+(
+    all [
+        (make deci! 3) = 3
+        ((make deci! 300) * (make deci! 1e-2)) = 3
+        (make deci! 0) = 0
+        (negate make deci! 0) = 0
+        lesser? (make deci! 2.5) 3
+        lesser? (make deci! -4) -3
+        not lesser? (make deci! 1e20) 3
+        (make deci! 0.1) = 0.1
+        lesser? (make deci! 0.1) 0.10000000000000002
+        lesser? ((make deci! 99) * (make deci! 1e100)) 1e300
+        not lesser? (make deci! 0) -1e300
+    ]
+)
+
+; equal decis with different bits are the same MAP! key
+(
+    m: make map! []
+    put m (make deci! 1) 'one
+    put m (make deci! 0) 'zero
+    hundredths: (make deci! 100) * (make deci! 1e-2)
+    all [
+        'one = select m hundredths
+        'zero = select m negate (make deci! 0)
+        'zero = select m (make deci! 0) * (make deci! 1e-5)
+    ]
+)
+
+; significand division with a divisor that needs the second limb to get
+; the quotient digit right (the 32-bit m_divide could be off by two)
+(
+    a: (make deci! -51454577389140111) * (make deci! 1e19)
+    b: (make deci! 5507158462174) * (make deci! 100.0)
+    (make deci! -453599616309400) = remainder a b
+)
+
+; DIVIDE-EACH prepares the divisor once, but must agree with DIVIDE
+(
+    rate: make deci! 1.0837
+    values: reduce [
+        make deci! 100
+        make deci! -12345
+        (make deci! 7) * (make deci! 1e20)
+        (make deci! 98765432109876543) * (make deci! 98765432109876543)
+    ]
+    (map-each 'v values [v / rate]) = divide-each values rate
+)
+(
+    values: reduce [make deci! 1 make deci! 2]
+    [0.5 1] = map-each 'v divide-each values 2 [to decimal! v]
+)
+
+; the -EACH natives run the array operations, pairwise or with one value
+(
+    a: reduce [make deci! 1.5 make deci! -2 (make deci! 3) * (make deci! 1e20)]
+    b: reduce [make deci! 0.25 make deci! 7 make deci! -1e-5]
+    all [
+        (reduce [a.1 + b.1 a.2 + b.2 a.3 + b.3]) = add-each a b
+        (reduce [a.1 - 7 a.2 - 7 a.3 - 7]) = subtract-each a 7
+        (reduce [a.1 * 0.5 a.2 * 0.5 a.3 * 0.5]) = multiply-each a 0.5
+        (reduce [a.1 / b.1 a.2 / b.2 a.3 / b.3]) = divide-each a b
+    ]
+)
+~bad-value~ !! (add-each [] reduce [make deci! 1])
+~zero-divide~ !! (divide-each reduce [make deci! 1 make deci! 2] 0)
+~zero-divide~ !! (divide-each reduce [make deci! 1] reduce [make deci! 0])
+
+; the BLOB! conversion reports an invalid significand without a RECOVER_SCOPE
+~overflow~ !! (make deci! #{FFFFFFFFFFFFFFFFFFFFFFFF})
+((make deci! 1) = make deci! #{000000000000000000000001})
+
+; SUM-EXACT rounds once, chained addition rounds at every step
+(
+    big: (make deci! 1) * (make deci! 1e20)
+    tiny: (make deci! 1) * (make deci! 1e-20)
+    all [
+        (make deci! 0) = (big + tiny) - big
+        tiny = sum-exact reduce [big tiny negate big]
+    ]
+)
+((make deci! 0) = sum-exact [])
+(
+    values: reduce [make deci! 0.1 make deci! 0.2 make deci! -0.3 make deci! 12.5]
+    (make deci! 12.5) = sum-exact values
+)
+
+; FMA rounds the exact a * b + c once, MULTIPLY then ADD round twice
+(
+    a: (make deci! 10000000000001) * (make deci! 1e-13)  ; 1.0000000000001
+    all [
+        ((make deci! 2) * (make deci! 1e-13)) = (a * a) - 1
+        ((make deci! 20000000000001) * (make deci! 1e-26)) = fma a a -1
+    ]
+)
+((make deci! 60.47) = fma (make deci! 19.99) 3 0.5)
+
+; DOT-PRODUCT keeps every product exact and rounds the sum once
+(
+    qty: reduce [make deci! 3 make deci! -2 make deci! 10]
+    price: reduce [make deci! 19.99 make deci! 0.5 make deci! 1.25]
+    (make deci! 71.97) = dot-product qty price
+)
+(
+    a: (make deci! 10000000000001) * (make deci! 1e-13)  ; 1.0000000000001
+    ((make deci! 20000000000001) * (make deci! 1e-26))
+        = dot-product reduce [a make deci! 1] reduce [a make deci! -1]
+)
+((make deci! 0) = dot-product [] [])
+~bad-value~ !! (dot-product reduce [make deci! 1] [])
+
+; SORT-DECI radix sorts on order-preserving keys
+(
+    one: make deci! 1
+    one-00: (make deci! 100) * (make deci! 1e-2)
+    values: reduce [
+        make deci! 2.5  one-00  make deci! -1e-20  make deci! 0
+        (make deci! -3) * (make deci! 1e100)  one  make deci! 1e-100
+    ]
+    (reduce [values.5 values.3 values.4 values.7 one-00 one values.1])
+        = sort-deci values
+)
+([] = sort-deci [])
+~bad-value~ !! (sort-deci [1 2])
+
+; DECI-VECTOR! keeps the values in packed columns
+(
+    values: reduce [make deci! 1.5 make deci! -2 (make deci! 3) * (make deci! 1e20)]
+    v: make deci-vector! values
+    all [
+        values = to block! v
+        (make deci! -2) = pick v 2
+        (reduce [values.1 + 1 values.2 + 1 values.3 + 1]) = to block! v + 1
+        (reduce [values.1 * values.1 values.2 * values.2 values.3 * values.3])
+            = to block! v * v
+        (make deci! 7) = poke v 2 make deci! 7
+        (make deci! 7) = pick v 2
+    ]
+)
+(
+    v: make deci-vector! 0
+    repeat 20 [append v make deci! 0.01]  ; grows the columns
+    (make deci! 0.2) = sum-exact to block! v
+)
+
+; vector + vector runs the SIMD column kernels where the CPU has them; a
+; block with equal exponents is done in the vector unit, a mixed one is not,
+; the results must be those of DECI! arithmetic lane for lane
+(
+    a: collect [count-up 'i 40 [keep make deci! i - 20]]
+    b: collect [count-up 'i 40 [
+        keep either i <= 16 [make deci! 3 * (17 - i)] [make deci! 0.5]
+    ]]
+    v: make deci-vector! a
+    w: make deci-vector! b
+    all [
+        (add-each a b) = to block! v + w
+        (subtract-each a b) = to block! v - w
+        (subtract-each b b) = to block! w - w
+    ]
+)
+~zero-divide~ !! (divide make deci-vector! reduce [make deci! 1] 0)
+~bad-value~ !! (add make deci-vector! [] make deci-vector! reduce [make deci! 1])
+
+; comparison and scaling by a power of ten run the column kernels too, the
+; results must be those of the DECI! operations value for value
+(
+    a: collect [count-up 'i 40 [keep make deci! i - 20]]
+    b: collect [count-up 'i 40 [
+        keep either i <= 16 [make deci! 3 * (17 - i) - 20] [make deci! 0.5]
+    ]]
+    v: make deci-vector! a
+    w: make deci-vector! b
+    expected: collect [count-up 'i 40 [
+        x: pick a i
+        y: pick b i
+        keep either lesser? x y [-1] [either x = y [0] [1]]
+    ]]
+    all [
+        expected = vector-compare v w
+        (map-each 'x a [0]) = vector-compare v make deci-vector! a
+        v = make deci-vector! a
+        not v = w
+        (map-each 'x a [x * make deci! 1e3]) = to block! vector-scale v 3
+        (map-each 'x b [x * make deci! 1e-2]) = to block! vector-scale w -2
+    ]
+)
+~bad-value~ !! (
+    vector-compare make deci-vector! [] make deci-vector! reduce [make deci! 1]
+)
+~overflow~ !! (vector-scale make deci-vector! reduce [make deci! 1] 200)
+
+; the vector reductions split the values over threads, the totals of the
+; parts merge exactly so any thread count gives the same bits
+(
+    one: make deci! 1
+    one-00: (make deci! 100) * (make deci! 1e-2)
+    v: make deci-vector! reduce [
+        make deci! 2.5  make deci! 0  one-00  make deci! -7  one
+        make deci! -7  (make deci! 1) * (make deci! 1e-20)
+    ]
+    all [
+        ((make deci! -9.5) + (make deci! 1e-20)) = vector-sum v
+        (make deci! -7) = vector-min v
+        (make deci! 2.5) = vector-max v
+        6 = vector-count v
+        (mold one-00) = mold vector-max make deci-vector! reduce [one-00 one]
+    ]
+)
+(
+    v: make deci-vector! 0
+    repeat 150000 [append v make deci! 0.01]  ; enough for 2 workers
+    poke v 100000 make deci! -5
+    all [
+        (vector-sum v) = vector-sum:threads v 1
+        (make deci! 1494.99) = vector-sum v
+        (make deci! -5) = vector-min:threads v 3
+        150000 = vector-count v
+    ]
+)
+((make deci! 0) = vector-sum make deci-vector! [])
+~bad-value~ !! (vector-min make deci-vector! [])
+
+; a block of DECI! is put in columns and reduced the same way
+(
+    b: reduce [make deci! 2.5  make deci! 0  make deci! -7  make deci! 1e-20]
+    v: make deci-vector! b
+    all [
+        (vector-sum v) = vector-sum b
+        (make deci! -7) = vector-min b
+        (make deci! 2.5) = vector-max b
+        3 = vector-count b
+    ]
+)
+(
+    b: make block! 150000
+    repeat 150000 [append b make deci! 0.01]
+    poke b 100000 make deci! -5
+    all [
+        (make deci! 1494.99) = vector-sum b
+        (vector-sum b) = vector-sum:threads b 1
+        (make deci! -5) = vector-min:threads b 3
+        (sum-exact b) = vector-sum b
+    ]
+)
+((make deci! 0) = vector-sum [])
+~bad-value~ !! (vector-max [])
+~bad-value~ !! (vector-sum reduce [make deci! 1 2])